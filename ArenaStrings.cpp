@@ -0,0 +1,23 @@
+#include "ArenaStrings.h"
+#include <cstring>
+
+// tamanho dos blocos da arena. Ids maiores que um bloco ganham um bloco só para eles
+#define TAM_BLOCO_ARENA 65536
+
+ArenaStrings::~ArenaStrings() {
+    for (int i = 0; i < blocos.size(); i++) delete[] (blocos[i]);
+}
+
+string_view ArenaStrings::guardar(string_view s) {
+    if (s.empty()) return string_view();
+    if (s.size() > tamanhoBloco - usadoBloco) {
+        tamanhoBloco = s.size() > TAM_BLOCO_ARENA ? s.size() : TAM_BLOCO_ARENA;
+        blocos.push_back(new char[tamanhoBloco]);
+        usadoBloco = 0;
+    }
+    char *destino = blocos.back() + usadoBloco;
+    memcpy(destino, s.data(), s.size());
+    usadoBloco += s.size();
+    bytesUsados += s.size();
+    return string_view(destino, s.size());
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Arena em que os ids dos nós são guardados uma única vez, em blocos contíguos que só são liberados junto com a arena.
+// As string_views devolvidas continuam válidas enquanto a arena existir, pois os blocos nunca são realocados. O espaço
+// dos ids de nós excluídos não é reaproveitado
+class ArenaStrings {
+private:
+    vector<char *> blocos;
+    size_t tamanhoBloco = 0; // tamanho do último bloco, o único que ainda recebe ids
+    size_t usadoBloco = 0;
+    size_t bytesUsados = 0;
+public:
+    ~ArenaStrings();
+
+    // copia a string para a arena e retorna a cópia
+    string_view guardar(string_view s);
+
+    size_t getBytesUsados() { return bytesUsados; };
+};
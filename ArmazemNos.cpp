@@ -0,0 +1,75 @@
+#include "ArmazemNos.h"
+
+void ArmazemNos::reservar(int numNos) {
+    ids.reserve(numNos);
+    graus.reserve(numNos);
+    arestas.reserve(numNos);
+}
+
+int ArmazemNos::adicionar(string_view id) {
+    ids.push_back(id);
+    graus.push_back(0);
+    arestas.emplace_back(&memoria);
+    return ids.size() - 1;
+}
+
+void ArmazemNos::remover(int indice) {
+    ids.erase(ids.begin() + indice);
+    graus.erase(graus.begin() + indice);
+    arestas.erase(arestas.begin() + indice);
+
+    for (int i = 0; i < arestas.size(); i++) {
+        removerAresta(i, indice);
+        // como as chaves da tabela são constantes, a tabela é reconstruída quando algum destino precisa ser renumerado.
+        // A reconstrução evita que um destino renumerado sobrescreva outro que ainda não foi visitado
+        bool renumerar = false;
+        for (auto aresta : arestas[i]) {
+            if (aresta.first > indice) {
+                renumerar = true;
+                break;
+            }
+        }
+        if (!renumerar) continue;
+        Adjacencia renumeradas(&memoria);
+        renumeradas.reserve(arestas[i].size());
+        for (auto aresta : arestas[i])
+            renumeradas.emplace(aresta.first > indice ? aresta.first - 1 : aresta.first, aresta.second);
+        arestas[i].swap(renumeradas);
+    }
+}
+
+void ArmazemNos::reordenar(const vector<int> &ordem) {
+    vector<int> novoIndice(ordem.size());
+    for (int i = 0; i < ordem.size(); i++) novoIndice[ordem[i]] = i;
+
+    vector<string_view> idsReordenados(ids.size());
+    vector<int> grausReordenados(graus.size());
+    vector<Adjacencia> arestasReordenadas;
+    arestasReordenadas.reserve(arestas.size());
+    for (int i = 0; i < ordem.size(); i++) {
+        idsReordenados[i] = ids[ordem[i]];
+        grausReordenados[i] = graus[ordem[i]];
+        arestasReordenadas.emplace_back(&memoria);
+        arestasReordenadas[i].reserve(arestas[ordem[i]].size());
+        for (auto aresta : arestas[ordem[i]]) arestasReordenadas[i].emplace(novoIndice[aresta.first], aresta.second);
+    }
+    ids.swap(idsReordenados);
+    graus.swap(grausReordenados);
+    arestas.swap(arestasReordenadas);
+}
+
+const pair<const int, int> *ArmazemNos::encontrarAresta(int origem, int destino) {
+    Adjacencia::const_iterator it = arestas[origem].find(destino);
+    if (it != arestas[origem].end()) return &(*it);
+    else return NULL;
+}
+
+void ArmazemNos::inserirAresta(int origem, int destino, int peso) {
+    if (arestas[origem].emplace(destino, peso).second) graus[origem]++;
+}
+
+int ArmazemNos::removerAresta(int origem, int destino) {
+    int n = arestas[origem].erase(destino);
+    if (n != 0) graus[origem]--;
+    return n;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <memory_resource>
+
+using namespace std;
+
+// arestas de um nó, do destino para o peso, alocadas no pool do ArmazemNos
+typedef pmr::unordered_map<int, int> Adjacencia;
+
+// Nós do grafo guardados como estrutura de arrays: o id, o grau e as arestas do nó i ocupam a posição i de vectors
+// paralelos, em vez de um objeto alocado separadamente por nó. Os percursos que só leem os graus, como o grau do grafo
+// ou a sequência de graus, acessam um único vector contíguo. As tabelas de arestas, que precisam continuar editáveis,
+// alocam os seus elementos de um pool único do armazém, liberado de uma vez na destruição, sem passar pelo heap a cada
+// aresta. O pool não é sincronizado: as leituras concorrentes não alocam, e as edições executam sozinhas
+class ArmazemNos {
+private:
+    pmr::unsynchronized_pool_resource memoria;
+    vector<string_view> ids; // apontam para a arena de ids do grafo
+    vector<int> graus;
+    vector<Adjacencia> arestas;
+public:
+    int size() const { return ids.size(); };
+
+    void reservar(int numNos);
+
+    // acrescenta um nó sem arestas e retorna o seu índice
+    int adicionar(string_view id);
+
+    // remove o nó e as arestas que chegam nele. Os índices dos nós seguintes, inclusive nas arestas, diminuem em 1
+    void remover(int indice);
+
+    // ordem[i] é o índice atual do nó que passa a ter o índice i. As arestas são renumeradas
+    void reordenar(const vector<int> &ordem);
+
+    string_view getId(int indice) { return ids[indice]; };
+
+    int getGrau(int indice) { return graus[indice]; };
+
+    const vector<int> &getGraus() { return graus; };
+
+    const Adjacencia &getArestas(int indice) { return arestas[indice]; };
+
+    // aresta da origem ao destino, ou NULL quando ela não existe
+    const pair<const int, int> *encontrarAresta(int origem, int destino);
+
+    // não faz nada caso a aresta já exista
+    void inserirAresta(int origem, int destino, int peso);
+
+    // retorna o número de arestas removidas
+    int removerAresta(int origem, int destino);
+};
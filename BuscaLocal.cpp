@@ -0,0 +1,165 @@
+#include "BuscaLocal.h"
+#include <algorithm>
+
+// atualiza a perda de um nó da cobertura, mantendo o ganho do seu único vizinho fora da cobertura, caso exista.
+// Nós com laço nunca podem sair da cobertura, portanto não contribuem para o ganho de nenhum nó
+void BuscaLocal::alterarVizinhosFora(int v, int novoValor) {
+    if (g->temLaco(v)) {
+        vizinhosFora[v] = novoValor;
+        return;
+    }
+
+    if (vizinhosFora[v] == 1) ganho[unicoFora[v]] -= g->getPeso(v);
+    vizinhosFora[v] = novoValor;
+
+    if (novoValor == 1) {
+        for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u) {
+            if (*u != v && !naCobertura[*u]) {
+                unicoFora[v] = *u;
+                break;
+            }
+        }
+        ganho[unicoFora[v]] += g->getPeso(v);
+        enfileirar(unicoFora[v]);
+    }
+}
+
+void BuscaLocal::adicionar(int u) {
+    // os nós que tinham u como único vizinho fora da cobertura zeram o ganho de u ao perderem esse vizinho
+    naCobertura[u] = true;
+
+    int fora = 0;
+    for (const int *x = g->vizinhosBegin(u); x != g->vizinhosEnd(u); ++x) {
+        if (*x == u) continue;
+        if (naCobertura[*x]) alterarVizinhosFora(*x, vizinhosFora[*x] - 1);
+        else fora++;
+    }
+
+    vizinhosFora[u] = 0;
+    alterarVizinhosFora(u, fora);
+}
+
+void BuscaLocal::remover(int v) {
+    // v deixa de contribuir para o ganho do seu único vizinho fora da cobertura
+    alterarVizinhosFora(v, 0);
+    naCobertura[v] = false;
+
+    // os vizinhos na cobertura passam a ter v como vizinho fora dela, o que atualiza o ganho de v
+    for (const int *y = g->vizinhosBegin(v); y != g->vizinhosEnd(v); ++y) {
+        if (*y != v && naCobertura[*y]) alterarVizinhosFora(*y, vizinhosFora[*y] + 1);
+    }
+}
+
+// só vale a pena avaliar a troca de um nó cujo ganho supera o seu próprio peso
+void BuscaLocal::enfileirar(int u) {
+    if (!naFila[u] && !naCobertura[u] && ganho[u] > g->getPeso(u)) {
+        naFila[u] = true;
+        fila.push_back(u);
+    }
+}
+
+// remove, em ordem decrescente de peso, os candidatos que não têm vizinhos fora da cobertura
+long long BuscaLocal::removerRedundantes(vector<int> &candidatos) {
+    GrafoCompacto *grafo = g;
+    sort(candidatos.begin(), candidatos.end(), [grafo](int a, int b) {
+        return grafo->getPeso(a) > grafo->getPeso(b);
+    });
+
+    long long economia = 0;
+    for (int i = 0; i < candidatos.size(); i++) {
+        int v = candidatos[i];
+        if (naCobertura[v] && !g->temLaco(v) && vizinhosFora[v] == 0) {
+            remover(v);
+            economia += g->getPeso(v);
+        }
+    }
+    return economia;
+}
+
+// Troca (k,1): u entra na cobertura e saem os vizinhos de u que o tinham como único vizinho fora da cobertura.
+// Dois desses vizinhos só podem sair juntos se não forem adjacentes, pois a aresta entre eles ficaria descoberta.
+// Portanto, eles são escolhidos em ordem decrescente de peso, ignorando os adjacentes aos já escolhidos.
+// A troca só é aplicada quando o peso que sai supera o peso de u
+long long BuscaLocal::aplicarTroca(int u) {
+    if (naCobertura[u] || ganho[u] <= g->getPeso(u)) return 0;
+
+    candidatosTroca.clear();
+    for (const int *x = g->vizinhosBegin(u); x != g->vizinhosEnd(u); ++x) {
+        if (*x != u && naCobertura[*x] && !g->temLaco(*x) && vizinhosFora[*x] == 1) candidatosTroca.push_back(*x);
+    }
+    GrafoCompacto *grafo = g;
+    sort(candidatosTroca.begin(), candidatosTroca.end(), [grafo](int a, int b) {
+        return grafo->getPeso(a) > grafo->getPeso(b);
+    });
+
+    saem.clear();
+    long long pesoSaem = 0;
+    for (int i = 0; i < candidatosTroca.size(); i++) {
+        int x = candidatosTroca[i];
+        bool adjacente = false;
+        for (const int *y = g->vizinhosBegin(x); y != g->vizinhosEnd(x) && !adjacente; ++y) adjacente = marcado[*y];
+        if (adjacente) continue;
+        marcado[x] = true;
+        saem.push_back(x);
+        pesoSaem += g->getPeso(x);
+    }
+    for (int i = 0; i < saem.size(); i++) marcado[saem[i]] = false;
+
+    if (pesoSaem <= g->getPeso(u)) return 0;
+
+    adicionar(u);
+    for (int i = 0; i < saem.size(); i++) remover(saem[i]);
+    return pesoSaem - g->getPeso(u);
+}
+
+long long BuscaLocal::melhorar(GrafoCompacto *g, vector<int> *solucao) {
+    this->g = g;
+    int n = g->getNumNos();
+    naCobertura.assign(n, false);
+    vizinhosFora.assign(n, 0);
+    unicoFora.assign(n, -1);
+    ganho.assign(n, 0);
+    naFila.assign(n, false);
+    marcado.assign(n, false);
+    fila.clear();
+
+    for (int i = 0; i < solucao->size(); i++) naCobertura[(*solucao)[i]] = true;
+
+    // calcula a perda de cada nó da cobertura e, consequentemente, o ganho dos nós fora dela
+    for (int i = 0; i < solucao->size(); i++) {
+        int v = (*solucao)[i];
+        int fora = 0;
+        for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u)
+            if (*u != v && !naCobertura[*u]) fora++;
+        alterarVizinhosFora(v, fora);
+    }
+
+    vector<int> candidatos(*solucao);
+    long long economia = removerRedundantes(candidatos);
+
+    // a fila contém os nós fora da cobertura cuja troca pode melhorar a solução. Cada troca aplicada diminui o peso
+    // da cobertura, o que garante que o laço termina
+    while (!fila.empty()) {
+        int u = fila.back();
+        fila.pop_back();
+        naFila[u] = false;
+        economia += aplicarTroca(u);
+    }
+
+    // reconstrói a solução mantendo a ordem original dos nós que permaneceram e acrescentando os que entraram
+    vector<int> melhorada;
+    for (int i = 0; i < solucao->size(); i++) {
+        int v = (*solucao)[i];
+        if (naCobertura[v] && !marcado[v]) {
+            marcado[v] = true;
+            melhorada.push_back(v);
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        if (naCobertura[v] && !marcado[v]) melhorada.push_back(v);
+        marcado[v] = false;
+    }
+    *solucao = melhorada;
+
+    return economia;
+}
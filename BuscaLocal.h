@@ -0,0 +1,43 @@
+#pragma once
+
+#include "GrafoCompacto.h"
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Busca local aplicada às soluções construídas pelos algoritmos gulosos de cobertura de vértices.
+// Primeiro são removidos os nós redundantes (cujos vizinhos já estão todos na cobertura). Em seguida, são aplicados
+// movimentos de troca (k,1): um nó u fora da cobertura entra e saem os nós da cobertura que tinham u como único
+// vizinho fora dela, o que inclui as trocas (1,1) e (2,1). Os vectors são indexados pelos nós e mantidos
+// incrementalmente, de forma que cada movimento custe somente a soma dos graus dos nós envolvidos.
+// Cada thread deve usar o seu próprio objeto, que reaproveita os vectors entre as chamadas
+class BuscaLocal {
+private:
+    GrafoCompacto *g = NULL;
+    vector<bool> naCobertura;
+    // "perda" de cada nó da cobertura: número de vizinhos fora da cobertura, isto é, arestas que ficariam
+    // descobertas caso o nó saísse
+    vector<int> vizinhosFora;
+    // para os nós da cobertura com exatamente um vizinho fora dela, guarda esse vizinho
+    vector<int> unicoFora;
+    // "ganho" de cada nó fora da cobertura: soma dos pesos dos nós da cobertura que o têm como único vizinho fora
+    // dela, isto é, o peso que pode sair da cobertura caso ele entre
+    vector<long long> ganho;
+    vector<int> fila;
+    vector<bool> naFila;
+    vector<bool> marcado;
+    // vizinhos que podem sair na troca avaliada e os que de fato saem, limpos a cada troca
+    vector<int> candidatosTroca;
+    vector<int> saem;
+
+    void alterarVizinhosFora(int v, int novoValor);
+    void adicionar(int u);
+    void remover(int v);
+    void enfileirar(int u);
+    long long removerRedundantes(vector<int> &candidatos);
+    long long aplicarTroca(int u);
+public:
+    // melhora a cobertura passada, substituindo-a pela cobertura melhorada, e retorna o peso que foi economizado
+    long long melhorar(GrafoCompacto *g, vector<int> *solucao);
+};
@@ -0,0 +1,220 @@
+#include "CoberturaExata.h"
+#include <algorithm>
+
+CoberturaExata::CoberturaExata(GrafoCompacto *g) : melhorIndependente(0), nosExplorados(0), interrompido(false) {
+    this->g = g;
+    n = g->getNumNos();
+    palavras = (n + 63) / 64;
+
+    // as posições dos bitsets seguem o grau crescente. Como o particionamento em cliques começa pelas menores
+    // posições, os nós de maior grau ficam nas últimas cliques e são os primeiros a serem ramificados
+    indice.resize(n);
+    for (int v = 0; v < n; v++) indice[v] = v;
+    stable_sort(indice.begin(), indice.end(), [g](int a, int b) { return g->getGrau(a) < g->getGrau(b); });
+    vector<int> posicao(n);
+    for (int i = 0; i < n; i++) posicao[indice[i]] = i;
+
+    adjacencia.assign((size_t) n * palavras, 0);
+    peso.resize(n);
+    for (int i = 0; i < n; i++) {
+        int v = indice[i];
+        peso[i] = g->getPeso(v);
+        pesoTotal += peso[i];
+        for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u) {
+            if (*u == v) continue;
+            int j = posicao[*u];
+            adjacencia[(size_t) i * palavras + j / 64] |= 1ULL << (j % 64);
+        }
+    }
+}
+
+void CoberturaExata::prepararProfundidade(EstadoBusca &e, int profundidade) {
+    while (e.candidatos.size() <= profundidade) {
+        e.candidatos.push_back(vector<unsigned long long>(palavras));
+        e.ordem.push_back(vector<int>());
+        e.limite.push_back(vector<long long>());
+    }
+    e.restantes.resize(palavras);
+    e.clique.resize(palavras);
+}
+
+// coloca no conjunto os candidatos cuja vizinhança entre os candidatos não pesa mais do que eles, retirando-os dos
+// candidatos junto com os seus vizinhos, e retorna quantos nós entraram no conjunto
+int CoberturaExata::reduzir(EstadoBusca &e, unsigned long long *candidatos, long long *pesoAtual) {
+    int adicionados = 0;
+    for (int w = 0; w < palavras; w++) {
+        unsigned long long bits = candidatos[w];
+        while (bits) {
+            int b = __builtin_ctzll(bits);
+            bits &= bits - 1;
+            // o nó pode ter saído dos candidatos por ser vizinho de um nó adicionado nesta mesma palavra
+            if (!((candidatos[w] >> b) & 1)) continue;
+
+            int v = w * 64 + b;
+            const unsigned long long *adj = vizinhos(v);
+            long long pesoVizinhanca = 0;
+            for (int x = 0; x < palavras && pesoVizinhanca <= peso[v]; x++) {
+                unsigned long long comuns = candidatos[x] & adj[x];
+                while (comuns && pesoVizinhanca <= peso[v]) {
+                    pesoVizinhanca += peso[x * 64 + __builtin_ctzll(comuns)];
+                    comuns &= comuns - 1;
+                }
+            }
+            if (pesoVizinhanca > peso[v]) continue;
+
+            for (int x = 0; x < palavras; x++) candidatos[x] &= ~adj[x];
+            candidatos[w] &= ~(1ULL << b);
+            e.conjunto.push_back(v);
+            *pesoAtual += peso[v];
+            adicionados++;
+        }
+    }
+    return adicionados;
+}
+
+// Particiona gulosamente os candidatos em cliques do grafo. A ordem recebe os candidatos clique a clique e o limite
+// de cada posição da ordem é a soma dos maiores pesos das cliques até a clique daquela posição, o que limita o peso
+// que os candidatos até aquela posição podem acrescentar ao conjunto independente
+void CoberturaExata::particionarEmCliques(EstadoBusca &e, const unsigned long long *candidatos, vector<int> &ordem,
+                                          vector<long long> &limite) {
+    ordem.clear();
+    limite.clear();
+    unsigned long long *restantes = e.restantes.data();
+    unsigned long long *clique = e.clique.data();
+
+    int numRestantes = 0;
+    for (int w = 0; w < palavras; w++) {
+        restantes[w] = candidatos[w];
+        numRestantes += __builtin_popcountll(candidatos[w]);
+    }
+
+    long long acumulado = 0;
+    while (numRestantes > 0) {
+        // os próximos nós da clique precisam ser adjacentes a todos os anteriores
+        for (int w = 0; w < palavras; w++) clique[w] = restantes[w];
+        long long maior = 0;
+        for (int w = 0; w < palavras; w++) {
+            while (clique[w]) {
+                int b = __builtin_ctzll(clique[w]);
+                int v = w * 64 + b;
+                restantes[w] &= ~(1ULL << b);
+                numRestantes--;
+                const unsigned long long *adj = vizinhos(v);
+                for (int x = w; x < palavras; x++) clique[x] &= adj[x];
+                ordem.push_back(v);
+                maior = max(maior, peso[v]);
+            }
+        }
+        acumulado += maior;
+        limite.resize(ordem.size(), acumulado);
+    }
+}
+
+void CoberturaExata::registrarConjunto(EstadoBusca &e, long long pesoAtual) {
+    if (pesoAtual <= melhorIndependente.load(memory_order_relaxed)) return;
+
+    lock_guard<mutex> lock(travaMelhor);
+    if (pesoAtual <= melhorIndependente.load(memory_order_relaxed)) return;
+    melhorIndependente.store(pesoAtual, memory_order_relaxed);
+    melhorConjunto = e.conjunto;
+    encontrou = true;
+}
+
+// explora o nó da árvore de busca cujos candidatos estão em e.candidatos[profundidade]
+void CoberturaExata::expandir(EstadoBusca &e, int profundidade, long long pesoAtual) {
+    // o prazo é verificado a cada 1024 nós explorados
+    if ((nosExplorados.fetch_add(1, memory_order_relaxed) & 1023) == 1023 && temPrazo &&
+        chrono::steady_clock::now() >= prazo)
+        interrompido = true;
+    if (interrompido.load(memory_order_relaxed)) return;
+
+    prepararProfundidade(e, profundidade + 1);
+    unsigned long long *candidatos = e.candidatos[profundidade].data();
+    unsigned long long *proximos = e.candidatos[profundidade + 1].data();
+    vector<int> &ordem = e.ordem[profundidade];
+    vector<long long> &limite = e.limite[profundidade];
+
+    int adicionados = reduzir(e, candidatos, &pesoAtual);
+    particionarEmCliques(e, candidatos, ordem, limite);
+
+    if (ordem.empty()) registrarConjunto(e, pesoAtual);
+
+    for (int i = (int) ordem.size() - 1; i >= 0; i--) {
+        // os limites diminuem ao longo da ramificação, portanto nenhum dos ramos seguintes pode melhorar a solução
+        if (pesoAtual + limite[i] <= melhorIndependente.load(memory_order_relaxed)) break;
+
+        int v = ordem[i];
+        const unsigned long long *adj = vizinhos(v);
+        for (int x = 0; x < palavras; x++) proximos[x] = candidatos[x] & ~adj[x];
+        proximos[v / 64] &= ~(1ULL << (v % 64));
+
+        e.conjunto.push_back(v);
+        expandir(e, profundidade + 1, pesoAtual + peso[v]);
+        e.conjunto.pop_back();
+
+        // no ramo seguinte, v está fora do conjunto
+        candidatos[v / 64] &= ~(1ULL << (v % 64));
+    }
+
+    e.conjunto.resize(e.conjunto.size() - adicionados);
+}
+
+bool CoberturaExata::resolver(long long pesoIncumbente, PoolThreads *pool, double tempoLimite, vector<int> *solucao,
+                              long long *pesoSolucao) {
+    temPrazo = tempoLimite > 0;
+    prazo = chrono::steady_clock::now() +
+            chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(tempoLimite));
+    melhorIndependente = pesoTotal - pesoIncumbente;
+    melhorConjunto.clear();
+    encontrou = false;
+    nosExplorados = 0;
+    interrompido = false;
+
+    // a raiz é explorada pela thread atual até o particionamento em cliques
+    EstadoBusca raiz;
+    prepararProfundidade(raiz, 0);
+    unsigned long long *todos = raiz.candidatos[0].data();
+    for (int v = 0; v < n; v++) todos[v / 64] |= 1ULL << (v % 64);
+    long long pesoRaiz = 0;
+    reduzir(raiz, todos, &pesoRaiz);
+    vector<int> &ordemRaiz = raiz.ordem[0];
+    vector<long long> &limiteRaiz = raiz.limite[0];
+    particionarEmCliques(raiz, todos, ordemRaiz, limiteRaiz);
+    if (ordemRaiz.empty()) registrarConjunto(raiz, pesoRaiz);
+
+    // cada ramo da raiz é uma tarefa. As tarefas começam pelos ramos das últimas cliques, que são os maiores, e cada
+    // thread pega a próxima tarefa livre ao terminar a anterior
+    vector<EstadoBusca> estados(pool->getNumThreads());
+    pool->paraCada(ordemRaiz.size(), [&](int tarefa, int idThread) {
+        int i = (int) ordemRaiz.size() - 1 - tarefa;
+        if (interrompido.load(memory_order_relaxed) ||
+            pesoRaiz + limiteRaiz[i] <= melhorIndependente.load(memory_order_relaxed))
+            return;
+
+        // os candidatos do ramo são os nós anteriores a v na ordem da raiz que não são adjacentes a v
+        EstadoBusca &e = estados[idThread];
+        prepararProfundidade(e, 0);
+        int v = ordemRaiz[i];
+        unsigned long long *candidatos = e.candidatos[0].data();
+        fill(candidatos, candidatos + palavras, 0ULL);
+        for (int j = 0; j < i; j++) candidatos[ordemRaiz[j] / 64] |= 1ULL << (ordemRaiz[j] % 64);
+        const unsigned long long *adj = vizinhos(v);
+        for (int x = 0; x < palavras; x++) candidatos[x] &= ~adj[x];
+
+        e.conjunto = raiz.conjunto;
+        e.conjunto.push_back(v);
+        expandir(e, 0, pesoRaiz + peso[v]);
+    });
+
+    *pesoSolucao = pesoTotal - melhorIndependente.load();
+    solucao->clear();
+    if (encontrou) {
+        // a cobertura é formada pelos nós fora do conjunto independente
+        vector<bool> noConjunto(n, false);
+        for (int i = 0; i < melhorConjunto.size(); i++) noConjunto[melhorConjunto[i]] = true;
+        for (int i = 0; i < n; i++)
+            if (!noConjunto[i]) solucao->push_back(indice[i]);
+    }
+
+    return !interrompido.load();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "GrafoCompacto.h"
+#include "PoolThreads.h"
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+using namespace std;
+
+// Cobertura mínima de vértices ponderados exata por branch-and-reduce. O complemento de uma cobertura é um conjunto
+// independente, portanto a busca maximiza o peso do conjunto independente e a cobertura é formada pelos demais nós.
+// As adjacências e os candidatos de cada nó da árvore de busca são bitsets, e em cada nó da árvore:
+// - os candidatos cuja vizinhança entre os candidatos não pesa mais do que eles entram no conjunto (redução);
+// - os candidatos são particionados gulosamente em cliques do grafo, e a soma dos maiores pesos das cliques limita
+//   o peso que ainda pode entrar no conjunto, já que cada clique contribui com no máximo um nó;
+// - a ramificação percorre os candidatos da última clique para a primeira: o nó entra no conjunto (os seus vizinhos
+//   entram na cobertura) ou sai dos candidatos (entra na cobertura), podando quando o limite não supera a melhor
+//   solução.
+// Os ramos da raiz são distribuídos entre as threads do pool, que compartilham o peso da melhor solução
+class CoberturaExata {
+private:
+    // dados de cada thread, com um bitset de candidatos e uma ordem de ramificação por profundidade da busca. Os
+    // deques mantêm válidas as referências das profundidades anteriores quando uma nova profundidade é criada
+    struct EstadoBusca {
+        deque<vector<unsigned long long>> candidatos;
+        deque<vector<int>> ordem;
+        deque<vector<long long>> limite;
+        vector<unsigned long long> restantes; // auxiliares do particionamento em cliques
+        vector<unsigned long long> clique;
+        vector<int> conjunto; // nós do conjunto independente atual
+    };
+
+    GrafoCompacto *g;
+    int n;
+    int palavras; // número de palavras de 64 bits de cada bitset
+    vector<int> indice; // nó do grafo correspondente a cada posição dos bitsets
+    vector<unsigned long long> adjacencia; // bitset das adjacências do nó v nas posições v * palavras em diante
+    vector<long long> peso;
+    long long pesoTotal = 0;
+
+    atomic<long long> melhorIndependente;
+    vector<int> melhorConjunto;
+    bool encontrou; // indica se alguma solução melhor do que a incumbente foi encontrada
+    mutex travaMelhor;
+
+    atomic<long long> nosExplorados;
+    atomic<bool> interrompido;
+    chrono::steady_clock::time_point prazo;
+    bool temPrazo;
+
+    const unsigned long long *vizinhos(int v) { return &adjacencia[(size_t) v * palavras]; };
+    void prepararProfundidade(EstadoBusca &e, int profundidade);
+    int reduzir(EstadoBusca &e, unsigned long long *candidatos, long long *pesoAtual);
+    void particionarEmCliques(EstadoBusca &e, const unsigned long long *candidatos, vector<int> &ordem,
+                              vector<long long> &limite);
+    void registrarConjunto(EstadoBusca &e, long long pesoAtual);
+    void expandir(EstadoBusca &e, int profundidade, long long pesoAtual);
+public:
+    CoberturaExata(GrafoCompacto *g);
+
+    // Busca uma cobertura de peso menor do que pesoIncumbente. Caso encontre, a melhor cobertura encontrada é guardada
+    // em solucao e o seu peso em pesoSolucao; caso contrário, solucao fica vazia e pesoSolucao recebe pesoIncumbente.
+    // Quando tempoLimite (em segundos) é positivo, a busca é interrompida no prazo. Retorna se a busca terminou, caso
+    // em que a melhor solução (a encontrada ou a incumbente) é ótima
+    bool resolver(long long pesoIncumbente, PoolThreads *pool, double tempoLimite, vector<int> *solucao,
+                  long long *pesoSolucao);
+
+    long long getNosExplorados() { return nosExplorados.load(); };
+};
@@ -0,0 +1,301 @@
+#include "FlorestaDinamica.h"
+#include <climits>
+#include <algorithm>
+
+FlorestaDinamica::FlorestaDinamica(int numVertices) {
+    for (int i = 0; i < numVertices; i++) adicionarVertice();
+}
+
+// vértices têm valor mínimo para nunca serem escolhidos como a aresta mais pesada de um caminho
+void FlorestaDinamica::adicionarVertice() {
+    noVertice.push_back(novoNo(INT_MIN, true));
+    arvorePorVertice.emplace_back();
+    foraPorVertice.emplace_back();
+    naParte.push_back(false);
+}
+
+int FlorestaDinamica::novoNo(int valorNo, bool vertice) {
+    int x;
+    if (!livres.empty()) {
+        x = livres.back();
+        livres.pop_back();
+    } else {
+        x = pai.size();
+        pai.push_back(-1);
+        filhoEsq.push_back(-1);
+        filhoDir.push_back(-1);
+        invertido.push_back(false);
+        valor.push_back(0);
+        maxNo.push_back(x);
+        ehVertice.push_back(false);
+        tamanho.push_back(0);
+        tamanhoVirtual.push_back(0);
+        origemAresta.push_back(-1);
+        destinoAresta.push_back(-1);
+    }
+    pai[x] = filhoEsq[x] = filhoDir[x] = -1;
+    invertido[x] = false;
+    valor[x] = valorNo;
+    maxNo[x] = x;
+    ehVertice[x] = vertice;
+    tamanho[x] = vertice ? 1 : 0;
+    tamanhoVirtual[x] = 0;
+    return x;
+}
+
+#pragma region Link-cut tree
+
+// um nó é raiz da sua splay tree quando o pai não o tem como filho (o ponteiro para o pai é um path-parent)
+bool FlorestaDinamica::ehRaiz(int x) {
+    int p = pai[x];
+    return p == -1 || (filhoEsq[p] != x && filhoDir[p] != x);
+}
+
+void FlorestaDinamica::atualizar(int x) {
+    tamanho[x] = (ehVertice[x] ? 1 : 0) + tamanhoVirtual[x];
+    if (filhoEsq[x] != -1) tamanho[x] += tamanho[filhoEsq[x]];
+    if (filhoDir[x] != -1) tamanho[x] += tamanho[filhoDir[x]];
+    maxNo[x] = x;
+    if (filhoEsq[x] != -1 && valor[maxNo[filhoEsq[x]]] > valor[maxNo[x]]) maxNo[x] = maxNo[filhoEsq[x]];
+    if (filhoDir[x] != -1 && valor[maxNo[filhoDir[x]]] > valor[maxNo[x]]) maxNo[x] = maxNo[filhoDir[x]];
+}
+
+// propaga a inversão pendente (usada por tornarRaiz) para os filhos
+void FlorestaDinamica::empurrar(int x) {
+    if (!invertido[x]) return;
+    swap(filhoEsq[x], filhoDir[x]);
+    if (filhoEsq[x] != -1) invertido[filhoEsq[x]] = !invertido[filhoEsq[x]];
+    if (filhoDir[x] != -1) invertido[filhoDir[x]] = !invertido[filhoDir[x]];
+    invertido[x] = false;
+}
+
+void FlorestaDinamica::rotacionar(int x) {
+    int p = pai[x], g = pai[p];
+    bool direita = filhoDir[p] == x;
+
+    if (!ehRaiz(p)) {
+        if (filhoEsq[g] == p) filhoEsq[g] = x;
+        else filhoDir[g] = x;
+    }
+    pai[x] = g;
+
+    if (direita) {
+        filhoDir[p] = filhoEsq[x];
+        if (filhoEsq[x] != -1) pai[filhoEsq[x]] = p;
+        filhoEsq[x] = p;
+    } else {
+        filhoEsq[p] = filhoDir[x];
+        if (filhoDir[x] != -1) pai[filhoDir[x]] = p;
+        filhoDir[x] = p;
+    }
+    pai[p] = x;
+
+    atualizar(p);
+    atualizar(x);
+}
+
+void FlorestaDinamica::splay(int x) {
+    // antes de rotacionar, as inversões pendentes do caminho até a raiz da splay tree precisam ser propagadas
+    vector<int> caminho(1, x);
+    for (int y = x; !ehRaiz(y); y = pai[y]) caminho.push_back(pai[y]);
+    for (int i = caminho.size() - 1; i >= 0; i--) empurrar(caminho[i]);
+
+    while (!ehRaiz(x)) {
+        int p = pai[x];
+        if (!ehRaiz(p)) {
+            int g = pai[p];
+            // zig-zig rotaciona o pai primeiro, zig-zag rotaciona o próprio nó duas vezes
+            if ((filhoEsq[g] == p) == (filhoEsq[p] == x)) rotacionar(p);
+            else rotacionar(x);
+        }
+        rotacionar(x);
+    }
+}
+
+// faz com que o caminho preferido da raiz até x contenha exatamente os nós do caminho na árvore representada.
+// O antigo filho direito de cada nó do caminho passa a ser uma subárvore virtual e o novo deixa de ser
+void FlorestaDinamica::acessar(int x) {
+    int ultimo = -1;
+    for (int y = x; y != -1; y = pai[y]) {
+        splay(y);
+        if (filhoDir[y] != -1) tamanhoVirtual[y] += tamanho[filhoDir[y]];
+        if (ultimo != -1) tamanhoVirtual[y] -= tamanho[ultimo];
+        filhoDir[y] = ultimo;
+        atualizar(y);
+        ultimo = y;
+    }
+    splay(x);
+}
+
+void FlorestaDinamica::tornarRaiz(int x) {
+    acessar(x);
+    invertido[x] = !invertido[x];
+}
+
+int FlorestaDinamica::acharRaiz(int x) {
+    acessar(x);
+    while (true) {
+        empurrar(x);
+        if (filhoEsq[x] == -1) break;
+        x = filhoEsq[x];
+    }
+    splay(x);
+    return x;
+}
+
+bool FlorestaDinamica::conectados(int x, int y) {
+    return x == y || acharRaiz(x) == acharRaiz(y);
+}
+
+// após o acesso, a splay tree de x contém o caminho até a raiz e todas as demais subárvores são virtuais
+int FlorestaDinamica::tamanhoArvore(int x) {
+    acessar(x);
+    return tamanho[x];
+}
+
+// retorna o nó de aresta mais pesado do caminho entre x e y, que precisam estar conectados
+int FlorestaDinamica::arestaMaisPesada(int x, int y) {
+    tornarRaiz(x);
+    acessar(y);
+    return maxNo[y];
+}
+
+// a árvore de u, que passa a ter u como raiz, é pendurada na aresta, que é pendurada em v. Como v é acessado antes,
+// somente ele precisa ter o tamanho atualizado
+void FlorestaDinamica::ligarAresta(int aresta) {
+    int u = noVertice[origemAresta[aresta]];
+    int v = noVertice[destinoAresta[aresta]];
+    tornarRaiz(u);
+    acessar(v);
+    pai[u] = aresta;
+    tamanhoVirtual[aresta] += tamanho[u];
+    atualizar(aresta);
+    pai[aresta] = v;
+    tamanhoVirtual[v] += tamanho[aresta];
+    atualizar(v);
+    arestasArvore.insert(aresta);
+    arvorePorVertice[origemAresta[aresta]].insert(aresta);
+    arvorePorVertice[destinoAresta[aresta]].insert(aresta);
+    pesoTotal += valor[aresta];
+}
+
+void FlorestaDinamica::cortarAresta(int aresta) {
+    // após tornar a aresta raiz e acessar cada vértice, o vértice fica como filho direito isolado da aresta
+    for (int vertice : {origemAresta[aresta], destinoAresta[aresta]}) {
+        tornarRaiz(aresta);
+        acessar(noVertice[vertice]);
+        filhoEsq[noVertice[vertice]] = -1;
+        pai[aresta] = -1;
+        atualizar(noVertice[vertice]);
+    }
+    tamanhoVirtual[aresta] = 0;
+    atualizar(aresta);
+    arestasArvore.erase(aresta);
+    arvorePorVertice[origemAresta[aresta]].erase(aresta);
+    arvorePorVertice[destinoAresta[aresta]].erase(aresta);
+    pesoTotal -= valor[aresta];
+}
+
+#pragma endregion
+
+int FlorestaDinamica::outraPonta(int aresta, int vertice) {
+    return origemAresta[aresta] == vertice ? destinoAresta[aresta] : origemAresta[aresta];
+}
+
+void FlorestaDinamica::adicionarFora(int aresta) {
+    foraPorVertice[origemAresta[aresta]].insert(make_pair(valor[aresta], aresta));
+    foraPorVertice[destinoAresta[aresta]].insert(make_pair(valor[aresta], aresta));
+}
+
+void FlorestaDinamica::removerFora(int aresta) {
+    foraPorVertice[origemAresta[aresta]].erase(make_pair(valor[aresta], aresta));
+    foraPorVertice[destinoAresta[aresta]].erase(make_pair(valor[aresta], aresta));
+}
+
+// Inserção: caso a aresta ligue duas árvores diferentes, ela entra na floresta. Caso contrário, ela forma um ciclo e
+// só entra na floresta se for mais leve do que a aresta mais pesada desse ciclo, que é então substituída
+void FlorestaDinamica::inserirAresta(int origem, int destino, int peso) {
+    if (arestas.find(make_pair(origem, destino)) != arestas.end()) return;
+
+    int aresta = novoNo(peso, false);
+    origemAresta[aresta] = origem;
+    destinoAresta[aresta] = destino;
+    arestas[make_pair(origem, destino)] = aresta;
+
+    // laços nunca fazem parte da floresta
+    if (origem == destino) {
+        adicionarFora(aresta);
+        return;
+    }
+
+    int u = noVertice[origem], v = noVertice[destino];
+    if (!conectados(u, v)) {
+        ligarAresta(aresta);
+        return;
+    }
+
+    int maisPesada = arestaMaisPesada(u, v);
+    if (valor[maisPesada] > peso) {
+        cortarAresta(maisPesada);
+        adicionarFora(maisPesada);
+        ligarAresta(aresta);
+    } else {
+        adicionarFora(aresta);
+    }
+}
+
+// Remoção: caso a aresta esteja na floresta, a árvore é dividida em duas e procuramos, entre as arestas fora da
+// floresta, a mais leve que reconecte as duas partes. Toda aresta que reconecta as partes incide na menor delas,
+// portanto basta percorrer a menor parte e, para cada vértice, as suas arestas fora da floresta em ordem de peso até a
+// primeira que sai da parte. O empate entre pesos é desfeito pelo nó da aresta
+void FlorestaDinamica::removerAresta(int origem, int destino) {
+    map<pair<int, int>, int>::iterator it = arestas.find(make_pair(origem, destino));
+    if (it == arestas.end()) return;
+
+    int aresta = it->second;
+    arestas.erase(it);
+
+    if (arestasArvore.count(aresta) == 0) {
+        removerFora(aresta);
+    } else {
+        cortarAresta(aresta);
+
+        int menor = tamanhoArvore(noVertice[origem]) <= tamanhoArvore(noVertice[destino]) ? origem : destino;
+        parte.assign(1, menor);
+        naParte[menor] = true;
+        for (int i = 0; i < parte.size(); i++) {
+            for (int arestaArvore : arvorePorVertice[parte[i]]) {
+                int w = outraPonta(arestaArvore, parte[i]);
+                if (naParte[w]) continue;
+                naParte[w] = true;
+                parte.push_back(w);
+            }
+        }
+
+        pair<int, int> substituta(0, -1); // (peso, nó) da aresta mais leve que sai da parte
+        for (int i = 0; i < parte.size(); i++) {
+            for (const pair<int, int> &candidata : foraPorVertice[parte[i]]) {
+                if (substituta.second != -1 && candidata >= substituta) break;
+                if (!naParte[outraPonta(candidata.second, parte[i])]) {
+                    substituta = candidata;
+                    break;
+                }
+            }
+        }
+        for (int i = 0; i < parte.size(); i++) naParte[parte[i]] = false;
+
+        if (substituta.second != -1) {
+            removerFora(substituta.second);
+            ligarAresta(substituta.second);
+        }
+    }
+
+    livres.push_back(aresta);
+}
+
+vector<tuple<int, int, int>> FlorestaDinamica::getArestas() {
+    vector<tuple<int, int, int>> result;
+    for (int aresta : arestasArvore)
+        result.push_back(make_tuple(origemAresta[aresta], destinoAresta[aresta], valor[aresta]));
+    return result;
+}
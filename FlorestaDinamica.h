@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <set>
+#include <tuple>
+
+using namespace std;
+
+// Floresta geradora mínima mantida incrementalmente sobre uma link-cut tree. Cada aresta da floresta é representada
+// por um nó próprio da link-cut tree, cujo valor é o peso da aresta, o que permite achar a aresta mais pesada do
+// caminho entre dois vértices em O(log n) amortizado. A link-cut tree também mantém o número de vértices de cada
+// subárvore, contando as subárvores penduradas por path-parents, o que dá o tamanho de cada árvore em O(log n).
+// Custos por edição: a inserção e a remoção de uma aresta fora da floresta custam O(log n) amortizado mais O(log E)
+// dos conjuntos de arestas fora da floresta. Ao remover uma aresta da floresta, a substituta é procurada somente entre
+// as arestas fora da floresta incidentes na menor das duas partes S, percorrida pelas arestas da floresta, o que custa
+// O((|S| + F(S)) log n), com F(S) o número dessas arestas. No pior caso (partes equilibradas e densas) isso ainda é
+// O(E log n); o custo polilogarítmico em qualquer caso exigiria a estrutura em níveis de Holm, de Lichtenberg e Thorup
+class FlorestaDinamica {
+private:
+    // estrutura da link-cut tree. Os nós são tanto os vértices do grafo quanto as arestas da floresta
+    vector<int> pai;
+    vector<int> filhoEsq;
+    vector<int> filhoDir;
+    vector<bool> invertido;
+    vector<int> valor;
+    vector<int> maxNo; // nó de maior valor da subárvore da splay tree
+    vector<bool> ehVertice; // somente os nós de vértices contam nos tamanhos
+    vector<int> tamanho; // vértices da subárvore da splay tree, incluindo as subárvores virtuais
+    vector<int> tamanhoVirtual; // vértices das subárvores penduradas no nó por path-parents
+
+    vector<int> noVertice; // nó da link-cut tree que representa cada vértice do grafo
+    vector<int> livres; // nós de aresta liberados que podem ser reaproveitados
+
+    // dados das arestas, indexados pelo nó da link-cut tree que as representa
+    vector<int> origemAresta;
+    vector<int> destinoAresta;
+
+    map<pair<int, int>, int> arestas; // (origem, destino) -> nó da aresta
+    set<int> arestasArvore; // nós das arestas que estão na floresta
+    vector<set<int>> arvorePorVertice; // nós das arestas da floresta incidentes em cada vértice
+    // (peso, nó) das arestas fora da floresta incidentes em cada vértice, ordenadas por peso
+    vector<set<pair<int, int>>> foraPorVertice;
+    int pesoTotal = 0;
+
+    // vértices da parte percorrida na busca da aresta substituta, reaproveitados entre as remoções
+    vector<int> parte;
+    vector<bool> naParte;
+
+    int novoNo(int valor, bool vertice);
+    bool ehRaiz(int x);
+    void atualizar(int x);
+    void empurrar(int x);
+    void rotacionar(int x);
+    void splay(int x);
+    void acessar(int x);
+    void tornarRaiz(int x);
+    int acharRaiz(int x);
+    bool conectados(int x, int y);
+    int tamanhoArvore(int x);
+    int arestaMaisPesada(int x, int y);
+    void ligarAresta(int aresta);
+    void cortarAresta(int aresta);
+    int outraPonta(int aresta, int vertice);
+    void adicionarFora(int aresta);
+    void removerFora(int aresta);
+public:
+    FlorestaDinamica(int numVertices);
+
+    void adicionarVertice();
+
+    void inserirAresta(int origem, int destino, int peso);
+
+    void removerAresta(int origem, int destino);
+
+    int getPesoTotal() { return pesoTotal; };
+
+    // retorna as arestas da floresta no formato origem, destino, peso
+    vector<tuple<int, int, int>> getArestas();
+};
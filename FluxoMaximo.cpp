@@ -0,0 +1,71 @@
+#include "FluxoMaximo.h"
+#include <queue>
+#include <algorithm>
+#include <climits>
+
+FluxoMaximo::FluxoMaximo(int numVertices) {
+    inicio.assign(numVertices, -1);
+    nivel.resize(numVertices);
+    atual.resize(numVertices);
+}
+
+void FluxoMaximo::adicionarArco(int origem, int destino, long long capacidade) {
+    this->destino.push_back(destino);
+    this->capacidade.push_back(capacidade);
+    proximo.push_back(inicio[origem]);
+    inicio[origem] = this->destino.size() - 1;
+
+    this->destino.push_back(origem);
+    this->capacidade.push_back(0);
+    proximo.push_back(inicio[destino]);
+    inicio[destino] = this->destino.size() - 1;
+}
+
+// busca em largura no grafo residual que calcula a distância de cada vértice à fonte
+bool FluxoMaximo::construirNiveis(int fonte, int sumidouro) {
+    fill(nivel.begin(), nivel.end(), -1);
+    queue<int> fila;
+    nivel[fonte] = 0;
+    fila.push(fonte);
+    while (!fila.empty()) {
+        int v = fila.front();
+        fila.pop();
+        for (int a = inicio[v]; a != -1; a = proximo[a]) {
+            if (capacidade[a] > 0 && nivel[destino[a]] == -1) {
+                nivel[destino[a]] = nivel[v] + 1;
+                fila.push(destino[a]);
+            }
+        }
+    }
+    return nivel[sumidouro] != -1;
+}
+
+// envia até limite unidades de fluxo de v ao sumidouro somente por arcos que avançam um nível. Os arcos saturados ou
+// sem saída são descartados da fase atual avançando atual[v]
+long long FluxoMaximo::aumentar(int v, int sumidouro, long long limite) {
+    if (v == sumidouro) return limite;
+
+    long long enviado = 0;
+    for (; atual[v] != -1; atual[v] = proximo[atual[v]]) {
+        int a = atual[v];
+        int d = destino[a];
+        if (capacidade[a] <= 0 || nivel[d] != nivel[v] + 1) continue;
+
+        long long f = aumentar(d, sumidouro, min(limite - enviado, capacidade[a]));
+        capacidade[a] -= f;
+        capacidade[a ^ 1] += f;
+        enviado += f;
+        if (enviado == limite) break;
+    }
+    return enviado;
+}
+
+long long FluxoMaximo::calcular(int fonte, int sumidouro) {
+    long long fluxo = 0;
+    while (construirNiveis(fonte, sumidouro)) {
+        atual = inicio;
+        long long f;
+        while ((f = aumentar(fonte, sumidouro, LLONG_MAX)) > 0) fluxo += f;
+    }
+    return fluxo;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+// Fluxo máximo pelo algoritmo de Dinic. Os arcos ficam em vectors contíguos, cada arco seguido do seu arco reverso,
+// de forma que o reverso do arco i seja o arco i ^ 1
+class FluxoMaximo {
+private:
+    vector<int> inicio; // primeiro arco de cada vértice na lista encadeada de arcos, ou -1
+    vector<int> proximo; // próximo arco do mesmo vértice de origem
+    vector<int> destino;
+    vector<long long> capacidade; // capacidade residual de cada arco
+    vector<int> nivel;
+    vector<int> atual; // próximo arco a ser explorado de cada vértice na fase atual
+
+    bool construirNiveis(int fonte, int sumidouro);
+    long long aumentar(int v, int sumidouro, long long limite);
+public:
+    FluxoMaximo(int numVertices);
+
+    void adicionarArco(int origem, int destino, long long capacidade);
+
+    long long calcular(int fonte, int sumidouro);
+};
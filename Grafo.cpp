@@ -1,37 +1,112 @@
 #include "Grafo.h"
-#include "Clock.h"
+#include "Perfilador.h"
 #include <sstream>
 #include <queue>
 #include <climits>
 #include <algorithm>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
 
 // variáveis usadas na verificação de grafo bipartido
 #define SEM_PARTICAO 0
 #define PARTICAO_A 1
 #define PARTICAO_B 2
 #define TAM_REATIVO 6
+// expoente usado no cálculo do vetor q do algoritmo reativo
+#define EXPOENTE_REATIVO 10
+// iterações por thread em cada bloco do GRASP com tempo limite. Entre os blocos, o prazo é verificado
+#define ITERACOES_POR_THREAD_BLOCO 4
+// número mínimo de arestas para que o Boruvka distribua a busca pelas arestas mais leves entre threads
+#define LIMIAR_BORUVKA_PARALELO 50000
+// número máximo de nós do grafo reduzido aceito pela cobertura exata, cujas adjacências ocupam n * n bits
+#define LIMITE_NOS_EXATO 5000
+// iterações e alpha do GRASP que fornece a solução inicial da cobertura exata
+#define ITERACOES_INCUMBENTE_EXATO 50
+#define ALFA_INCUMBENTE_EXATO 0.2
+// número de soluções do conjunto elite do religamento de caminhos
+#define TAM_ELITE 10
+// as soluções do conjunto elite diferem em pelo menos numNos / DIVISOR_DISTANCIA_ELITE nós
+#define DIVISOR_DISTANCIA_ELITE 100
+// número de hashes de soluções lembrados pelo GRASP para ignorar as repetidas. Os mais antigos são esquecidos
+#define MAX_SOLUCOES_VISTAS 65536
+// iterações entre os religamentos do GRASP limitado pelo número de iterações
+#define ITERACOES_ENTRE_RELIGAMENTOS 32
+// arquivo opcional com os pesos dos nós, cujo nome é o do arquivo de entrada seguido desta extensão
+#define EXTENSAO_ARQUIVO_PESOS ".pesos"
+// peso dos nós que não constam no arquivo de pesos
+#define PESO_PADRAO(indice) ((indice) % 3 + 1)
 
 #pragma region Construtor
 
 // construtor padrão
 Grafo::Grafo(string nomeArquivoEntrada, string nomeArquivoSaida) {
+    semente = (unsigned long long) time(0);
     lerArquivo(nomeArquivoEntrada);
     this->nomeArquivoSaida = nomeArquivoSaida;
 }
 
 //construtor auxiliar para gerar grafo transposto (usado para calcular as componentes fortemente conexas)
-Grafo::Grafo(vector<string> ids, vector<tuple<int, int, int>> *arestas) {
+// os ids apontam para a arena do grafo original, que existe enquanto o transposto for usado
+Grafo::Grafo(vector<string_view> ids, vector<tuple<int, int, int>> *arestas) {
     isDigrafo = true;
 
-    nos = vector<No *>(ids.size());
+    nos.reservar(ids.size());
+
+    pesoNos = vector<long long>(ids.size(), 0);
 
     for (int i = 0; i < ids.size(); i++) {
-        nos[i] = new No(ids[i], 0);
+        nos.adicionar(ids[i]);
     }
 
     for (int i = 0; i < arestas->size(); i++) {
         // como é transposto, inserir as arestas invertidas
-        nos[get<1>((*arestas)[i])]->inserirAresta(get<0>((*arestas)[i]), get<2>((*arestas)[i]));
+        nos.inserirAresta(get<1>((*arestas)[i]), get<0>((*arestas)[i]), get<2>((*arestas)[i]));
+    }
+    definirVariante();
+}
+
+#pragma endregion
+
+/*Nessa região está a escolha da variante do grafo. A direção e a ponderação não mudam depois da leitura, portanto os
+ * laços sobre as arestas são instanciados para cada combinação e a variante escolhe a instanciação uma vez por chamada,
+ * em vez de testar isDigrafo e isPonderado a cada aresta*/
+#pragma region Variante
+
+void Grafo::definirVariante() {
+    if (isDigrafo) variante = isPonderado ? DIRECIONADO_PONDERADO : DIRECIONADO_NAO_PONDERADO;
+    else variante = isPonderado ? NAO_DIRECIONADO_PONDERADO : NAO_DIRECIONADO_NAO_PONDERADO;
+}
+
+// chama f(origem, destino, peso) uma vez para cada aresta. Em grafos não direcionados, cada aresta é visitada a partir
+// da sua ponta de menor índice e, em grafos não ponderados, o peso é a constante 1
+template<bool Digrafo, bool Ponderado, typename Funcao>
+void Grafo::paraCadaArestaAux(Funcao f) {
+    for (int i = 0; i < nos.size(); i++) {
+        for (const auto &aresta : nos.getArestas(i))
+            if (Digrafo || aresta.first >= i) f(i, aresta.first, Ponderado ? aresta.second : 1);
+    }
+}
+
+template<typename Funcao>
+void Grafo::paraCadaAresta(Funcao f) {
+    switch (variante) {
+        case NAO_DIRECIONADO_NAO_PONDERADO:
+            paraCadaArestaAux<false, false>(f);
+            break;
+        case NAO_DIRECIONADO_PONDERADO:
+            paraCadaArestaAux<false, true>(f);
+            break;
+        case DIRECIONADO_NAO_PONDERADO:
+            paraCadaArestaAux<true, false>(f);
+            break;
+        case DIRECIONADO_PONDERADO:
+            paraCadaArestaAux<true, true>(f);
+            break;
     }
 }
 
@@ -41,6 +116,7 @@ Grafo::Grafo(vector<string> ids, vector<tuple<int, int, int>> *arestas) {
 #pragma region  Arquivo
 
 void Grafo::lerArquivo(string nomeArquivoEntrada) {
+    PERFIL_ZONA("lerArquivo");
     ifstream infile(nomeArquivoEntrada);
 
     if (!infile.is_open()) {
@@ -52,13 +128,14 @@ void Grafo::lerArquivo(string nomeArquivoEntrada) {
     getline(infile, auxStr);
     unsigned int numNos = (unsigned int) atoi(auxStr.c_str());
 
-    nos = vector<No *>(numNos, NULL);
+    nos.reservar(numNos);
+    pesoNos.reserve(numNos);
     vector<tuple<int, int, int>> arestas;
 
     map<pair<int, int>, bool> arestaMap;
-    map<string, int>::iterator it;
     map<pair<int, int>, bool>::iterator itPair;
-    int indiceProximo = 0, indiceOrigem, indiceDestino, peso;
+    idMap.reservar(numNos);
+    int indiceOrigem, indiceDestino, peso;
 
     while (getline(infile, line)) {
         if (line[0] == ' ') {
@@ -86,26 +163,21 @@ void Grafo::lerArquivo(string nomeArquivoEntrada) {
             peso = 1;
         }
 
-        it = idMap.find(origem);
+        indiceOrigem = idMap.buscar(origem);
 
-        if (it == idMap.end()) {
-            idMap[origem] = indiceProximo;
-            nos[indiceProximo] = new No(origem, indiceProximo % 3 + 1);
-            indiceOrigem = indiceProximo; // caso o nó não exista ainda, precisamos setar novamente o indiceOrigem
-            indiceProximo++;  // caso ambos origem e destino não existam, incrementar o i aqui fará com que os dois sejam criados adequadamente
-        } else {
-            indiceOrigem = it->second;
+        if (indiceOrigem == -1) {
+            // caso o nó não exista ainda, ele é acrescentado ao fim, com o próximo índice
+            indiceOrigem = nos.adicionar(arenaIds.guardar(origem));
+            idMap.inserir(nos.getId(indiceOrigem), indiceOrigem);
+            pesoNos.push_back(PESO_PADRAO(indiceOrigem));
         }
 
-        it = idMap.find(destino);
+        indiceDestino = idMap.buscar(destino);
 
-        if (it == idMap.end()) {
-            idMap[destino] = indiceProximo;
-            nos[indiceProximo] = new No(destino, indiceProximo % 3 + 1);
-            indiceDestino = indiceProximo; // caso o nó não exista ainda, precisamos setar novamente o indiceDestino
-            indiceProximo++;
-        } else {
-            indiceDestino = it->second;
+        if (indiceDestino == -1) {
+            indiceDestino = nos.adicionar(arenaIds.guardar(destino));
+            idMap.inserir(nos.getId(indiceDestino), indiceDestino);
+            pesoNos.push_back(PESO_PADRAO(indiceDestino));
         }
 
         if (!isDigrafo) { // caso já seja digrafo, não há necessidade de checar novamente
@@ -117,30 +189,64 @@ void Grafo::lerArquivo(string nomeArquivoEntrada) {
         arestas.push_back(make_tuple(indiceOrigem, indiceDestino, peso));
     }
 
-    // devemos checar por nós sem arestas e atribuí-los com um id default
-    for (int i = numNos - 1; i >= 0; i--) {
-        // como os ids foram lidos de uma forma incremental, caso encontremos um nó válido, temos certeza que todos os nós nulos já foram preenchidos
-        if (nos[i] != NULL) break;
-        string id = nomeDefaultNosSemAresta + to_string(numNos - i);
-        nos[i] = new No(id, i % 3 + 1);
-        idMap.insert(make_pair(id, i));
+    // os nós que faltam para completar o número informado no arquivo não têm arestas e recebem um id default
+    for (int i = nos.size(); i < (int) numNos; i++) {
+        nos.adicionar(arenaIds.guardar(nomeDefaultNosSemAresta + to_string(numNos - i)));
+        pesoNos.push_back(PESO_PADRAO(i));
+        idMap.inserir(nos.getId(i), i);
     }
 
-    No *aux;
     for (int i = 0; i < arestas.size(); i++) {
-        aux = nos[get<0>(arestas[i])];
-        aux->inserirAresta(get<1>(arestas[i]), get<2>(arestas[i]));
+        nos.inserirAresta(get<0>(arestas[i]), get<1>(arestas[i]), get<2>(arestas[i]));
 
         // caso não seja digrafo e não seja um laço, devemos adicionar uma aresta no nó destino também
         if (!isDigrafo && get<0>(arestas[i]) != get<1>(arestas[i])) {
-            aux = nos[get<1>(arestas[i])];
             // invertemos a ordem para facilitar a busca posteriormente
-            aux->inserirAresta(get<0>(arestas[i]), get<2>(arestas[i]));
+            nos.inserirAresta(get<1>(arestas[i]), get<0>(arestas[i]), get<2>(arestas[i]));
+        }
+    }
+
+    lerArquivoPesos(nomeArquivoEntrada + EXTENSAO_ARQUIVO_PESOS);
+    definirVariante();
+}
+
+// Lê os pesos dos nós de um arquivo com uma linha "id peso" por nó. O arquivo é opcional: quando ele não existe, ou
+// não contém algum nó, o peso do nó segue a regra padrão. Os pesos são inteiros não negativos de 64 bits
+void Grafo::lerArquivoPesos(string nomeArquivoPesos) {
+    PERFIL_ZONA("lerArquivoPesos");
+    ifstream infile(nomeArquivoPesos);
+    if (!infile.is_open()) return;
+
+    string id, auxStr, line;
+    int numLidos = 0, numLinha = 0;
+    while (getline(infile, line)) {
+        numLinha++;
+        istringstream iss(line);
+        if (!(iss >> id)) continue; // linhas em branco são ignoradas
+
+        // o peso precisa ser um inteiro não negativo que ocupe todo o restante da linha
+        char *fim = NULL;
+        long long peso = -1;
+        if (iss >> auxStr) peso = strtoll(auxStr.c_str(), &fim, 10);
+        if (peso < 0 || *fim != '\0' || (iss >> auxStr)) {
+            cout << "Peso invalido na linha " << numLinha << " de " << nomeArquivoPesos << "\n";
+            continue;
         }
+
+        int indice = idMap.buscar(id);
+        if (indice == -1) {
+            cout << "No " << id << " da linha " << numLinha << " de " << nomeArquivoPesos << " nao existe no grafo\n";
+            continue;
+        }
+        pesoNos[indice] = peso;
+        numLidos++;
     }
+
+    cout << "Pesos de " << numLidos << " de " << nos.size() << " nos lidos de " << nomeArquivoPesos << "\n";
 }
 
 void Grafo::salvarArquivo() {
+    PERFIL_ZONA("salvarArquivo");
     ofstream infile(nomeArquivoSaida);
 
     if (!infile.is_open()) {
@@ -150,15 +256,17 @@ void Grafo::salvarArquivo() {
 
     infile << nos.size() << endl;
 
-    unordered_map<int, int> arestas;
-    for (int i = 0; i < nos.size(); i++) {
-        arestas = *(nos[i]->getArestas());
+    // os nós são escritos na ordem do arquivo de entrada, mesmo quando foram reordenados na memória
+    for (int posicao = 0; posicao < nos.size(); posicao++) {
+        int i = posicaoArquivo.empty() ? posicao : indicePorPosicao[posicao];
+        const Adjacencia &arestas = nos.getArestas(i);
         for (auto aresta : arestas) {
-            if (isDigrafo || aresta.first >= i) {
+            int posicaoDestino = posicaoArquivo.empty() ? aresta.first : posicaoArquivo[aresta.first];
+            if (isDigrafo || posicaoDestino >= posicao) {
                 // caso seja digrafo, todas as arestas devem ser escritas. Caso contrário,
                 // somente as arestas que se relacionam com nós maiores devem ser adicionadas pois
                 // uma das duas arestas geradas em grafos não direcionados já foi escrita
-                infile << nos[i]->getId() << " " << nos[aresta.first]->getId();
+                infile << nos.getId(i) << " " << nos.getId(aresta.first);
                 // caso seja ponderado, salvamos o peso também
                 if (isPonderado) infile << " " << aresta.second;
                 infile << endl;
@@ -173,43 +281,176 @@ void Grafo::salvarArquivo() {
 
 #pragma endregion
 
+/*Nessa região estão desenvolvidas as funções que reordenam os índices dos nós para que nós vizinhos fiquem próximos
+ * na memória. Os índices vêm da ordem de aparição no arquivo, que espalha os vizinhos e faz com que as travessias
+ * percam a cache. As ordens são calculadas sobre a representação compacta, que já tem os vizinhos ordenados*/
+#pragma region Ordem dos Nós
+
+// ordem de Cuthill-McKee reversa: busca em largura a partir do nó de menor grau de cada componente, visitando os
+// vizinhos em ordem crescente de grau, com a ordem final invertida. Reduz a largura de banda da matriz de adjacência
+static vector<int> ordemCuthillMcKeeReversa(GrafoCompacto *g) {
+    int n = g->getNumNos();
+    vector<int> porGrau(n);
+    for (int v = 0; v < n; v++) porGrau[v] = v;
+    stable_sort(porGrau.begin(), porGrau.end(), [g](int a, int b) { return g->getGrau(a) < g->getGrau(b); });
+
+    vector<int> ordem;
+    ordem.reserve(n);
+    vector<bool> visitado(n, false);
+    vector<int> vizinhos;
+    for (int i = 0; i < n; i++) {
+        if (visitado[porGrau[i]]) continue;
+        int inicio = ordem.size();
+        visitado[porGrau[i]] = true;
+        ordem.push_back(porGrau[i]);
+        // a própria ordem serve de fila da busca em largura
+        for (int atual = inicio; atual < ordem.size(); atual++) {
+            vizinhos.clear();
+            for (const int *w = g->vizinhosBegin(ordem[atual]); w != g->vizinhosEnd(ordem[atual]); w++) {
+                if (!visitado[*w]) {
+                    visitado[*w] = true;
+                    vizinhos.push_back(*w);
+                }
+            }
+            stable_sort(vizinhos.begin(), vizinhos.end(), [g](int a, int b) { return g->getGrau(a) < g->getGrau(b); });
+            ordem.insert(ordem.end(), vizinhos.begin(), vizinhos.end());
+        }
+    }
+    reverse(ordem.begin(), ordem.end());
+    return ordem;
+}
+
+// nós em ordem decrescente de grau, de forma que os nós mais acessados fiquem juntos no começo
+static vector<int> ordemPorGrau(GrafoCompacto *g) {
+    int n = g->getNumNos();
+    vector<int> ordem(n);
+    for (int v = 0; v < n; v++) ordem[v] = v;
+    stable_sort(ordem.begin(), ordem.end(), [g](int a, int b) { return g->getGrau(a) > g->getGrau(b); });
+    return ordem;
+}
+
+// ordem de visita de uma busca em largura iniciada no nó 0 e continuada pelas demais componentes
+static vector<int> ordemLargura(GrafoCompacto *g) {
+    int n = g->getNumNos();
+    vector<int> ordem;
+    ordem.reserve(n);
+    vector<bool> visitado(n, false);
+    for (int v = 0; v < n; v++) {
+        if (visitado[v]) continue;
+        visitado[v] = true;
+        ordem.push_back(v);
+        for (int atual = ordem.size() - 1; atual < ordem.size(); atual++) {
+            for (const int *w = g->vizinhosBegin(ordem[atual]); w != g->vizinhosEnd(ordem[atual]); w++) {
+                if (!visitado[*w]) {
+                    visitado[*w] = true;
+                    ordem.push_back(*w);
+                }
+            }
+        }
+    }
+    return ordem;
+}
+
+// reordena os nós pelo critério informado: rcm (Cuthill-McKee reversa), grau ou largura. Os ids não mudam, somente os
+// índices, e a ordem do arquivo de entrada continua guardada para a escrita do grafo. Retorna false quando o critério
+// não existe
+bool Grafo::reordenarNos(string criterio) {
+    PERFIL_ZONA("reordenarNos");
+    vector<int> ordem;
+    if (criterio == "rcm") ordem = ordemCuthillMcKeeReversa(getGrafoCompacto());
+    else if (criterio == "grau") ordem = ordemPorGrau(getGrafoCompacto());
+    else if (criterio == "largura") ordem = ordemLargura(getGrafoCompacto());
+    else return false;
+
+    aplicarOrdem(ordem);
+    return true;
+}
+
+// ordem[i] é o índice atual do nó que passa a ter o índice i
+void Grafo::aplicarOrdem(const vector<int> &ordem) {
+    nos.reordenar(ordem);
+    vector<long long> pesosReordenados(nos.size());
+    vector<int> posicoes(nos.size());
+    for (int i = 0; i < ordem.size(); i++) {
+        pesosReordenados[i] = pesoNos[ordem[i]];
+        posicoes[i] = posicaoArquivo.empty() ? ordem[i] : posicaoArquivo[ordem[i]];
+        idMap.inserir(nos.getId(i), i);
+    }
+    pesoNos.swap(pesosReordenados);
+    posicaoArquivo.swap(posicoes);
+    indicePorPosicao.assign(nos.size(), 0);
+    for (int i = 0; i < nos.size(); i++) indicePorPosicao[posicaoArquivo[i]] = i;
+
+    if (agmDinamica != NULL) construirAGMDinamica();
+    invalidarGrafoCompacto();
+}
+
+#pragma endregion
+
 /*Nessa região estão desenvolvidas as funções que irão manipular (Adicionar, Editar e Excluir) um nó e as funções que retornam informações de um nó*/
 #pragma region Manipulação e Informação do Nó
 
-void Grafo::inserirNo(string id) {
+bool Grafo::inserirNo(string id) {
     int i = getIndexNo(id);
     if (i != -1) {
         cout << "O no " << id << " ja existe neste grafo! Favor informar outro id.\n";
-        return;
+        return false;
     }
 
-    No *no = new No(id, nos.size() % 3 + 1);
-    nos.push_back(no);
-    idMap[id] = nos.size() - 1;
+    pesoNos.push_back(PESO_PADRAO(nos.size()));
+    int indice = nos.adicionar(arenaIds.guardar(id));
+    idMap.inserir(nos.getId(indice), indice);
+    if (!posicaoArquivo.empty()) {
+        // nós inseridos depois de uma reordenação ficam no fim da ordem do arquivo
+        posicaoArquivo.push_back(nos.size() - 1);
+        indicePorPosicao.push_back(nos.size() - 1);
+    }
+    if (agmDinamica != NULL) agmDinamica->adicionarVertice();
+    invalidarGrafoCompacto();
     cout << "No " << id << " inserido com sucesso!\n";
+    return true;
 }
 
-void Grafo::excluirNo(string id) {
+bool Grafo::excluirNo(string id) {
     int indice = getIndexNo(id);
     if (indice == -1) {
         printMensagemNoInexistente(id);
-        return;
+        return false;
+    }
+
+    // o armazém remove as arestas que tinham o nó excluído como destino e atualiza os índices dos destinos seguintes
+    nos.remover(indice);
+    pesoNos.erase(pesoNos.begin() + indice);
+    idMap.remover(id); // apagar a chave do id passado do map de IDs
+    // também é necessário atualizar o map de ids dos nós que vinham depois do excluído
+    for (int i = indice; i < nos.size(); i++) idMap.inserir(nos.getId(i), i);
+    if (!posicaoArquivo.empty()) {
+        // a posição do nó excluído sai da ordem do arquivo e as posições e índices seguintes diminuem
+        int posicao = posicaoArquivo[indice];
+        posicaoArquivo.erase(posicaoArquivo.begin() + indice);
+        indicePorPosicao.erase(indicePorPosicao.begin() + posicao);
+        for (int i = 0; i < nos.size(); i++) {
+            if (posicaoArquivo[i] > posicao) posicaoArquivo[i]--;
+            if (indicePorPosicao[i] > indice) indicePorPosicao[i]--;
+        }
     }
 
-    delete (nos[indice]);  // desalocar mémoria do nó
-    nos.erase(nos.begin() + indice);
-    idMap.erase(id); // apagar a chave do id passado do map de IDs
-    for (int i = 0; i < nos.size(); i++) {
-        nos[i]->removerAresta(indice); // remover todas as arestas que tinham o nó excluído como destino
-        nos[i]->atualizarIndices(indice); // como as arestas mantém os índices dos nós destino, precisamos atualizá-los
-        idMap[nos[i]->getId()] = i; // também é necessário atualizar o map de ids
-    }
+    // como os índices dos nós mudaram, a AGM mantida precisa ser reconstruída, em O(E log n)
+    if (agmDinamica != NULL) construirAGMDinamica();
+    invalidarGrafoCompacto();
 
     cout << "O no " << id << " e suas arestas foram removidos com sucesso!\n";
+    return true;
 }
 
 int Grafo::adicionarNoInexistente(string id) {
-    // retorna o índice do nó caso o nó foi adicionado com sucesso e -1 caso contrário
+    // retorna o índice do nó caso o nó foi adicionado com sucesso e -1 caso contrário. Fora do modo interativo, o nó é
+    // adicionado sem perguntar, como na leitura do arquivo
+    if (!interativo) {
+        inserirNo(id);
+        return nos.size() - 1;
+    }
+
     string escolha;
     do {
         cout << "\nNo " << id << " nao existe no grafo! Deseja adiciona-lo (s/n)? ";
@@ -227,6 +468,22 @@ int Grafo::adicionarNoInexistente(string id) {
     return -1;
 }
 
+int Grafo::getGrauSaida(int indice) {
+    return nos.getGrau(indice);
+}
+
+// em grafos não direcionados, o grau de entrada é igual ao de saída
+int Grafo::getGrauEntrada(int indice) {
+    if (!isDigrafo) return nos.getGrau(indice);
+
+    int grauEntrada = 0;
+    for (int i = 0; i < nos.size(); i++) {
+        if (i == indice) continue;
+        if (nos.encontrarAresta(i, indice) != NULL) grauEntrada++;
+    }
+    return grauEntrada;
+}
+
 void Grafo::grauNo(string id) {
     int indice = getIndexNo(id);
     if (indice == -1) {
@@ -235,23 +492,21 @@ void Grafo::grauNo(string id) {
     }
 
     if (isDigrafo) {
-        int grauEntrada = 0;
-        for (int i = 0; i < nos.size(); i++) {
-            if (i == indice) continue;
-            if (nos[i]->encontrarArestasComDestino(indice) != NULL) grauEntrada++;
-        }
-
-        cout << "Grau de entrada: " << grauEntrada << endl;
-        cout << "Grau de saida: " << nos[indice]->getGrau() << endl;
+        cout << "Grau de entrada: " << getGrauEntrada(indice) << endl;
+        cout << "Grau de saida: " << getGrauSaida(indice) << endl;
     } else {
-        cout << "Grau: " << nos[indice]->getGrau() << endl;
+        cout << "Grau: " << getGrauSaida(indice) << endl;
     }
 }
 
-int Grafo::getIndexNo(string id) {
-    map<string, int>::iterator it = idMap.find(id);
-    if (it == idMap.end()) return -1;
-    else return it->second;
+// o fecho transitivo direto de um nó é o mesmo conjunto alcançados pela busca em profundidade, partindo deste nó
+vector<int> Grafo::getFechoTransitivoDireto(int indice) {
+    vector<bool> visitados(nos.size(), false);
+    vector<int> fecho;
+    long long arestasVisitadas = 0;
+    buscaEmProfundidadeAux(indice, &visitados, &fecho, &arestasVisitadas);
+    metricas.adicionar(BUSCA_ARESTAS_VISITADAS, arestasVisitadas);
+    return fecho;
 }
 
 void Grafo::fechoTransitivoDireto(string id) {
@@ -261,11 +516,24 @@ void Grafo::fechoTransitivoDireto(string id) {
         return;
     }
 
-    cout << "Fecho Transitivo Direto: ";
-    // o fecho transitivo direto de um nó é o mesmo conjunto alcançados pela busca em profundidade, partindo deste nó
-    vector<bool> visitados(nos.size(), false);
-    buscaEmProfundidadeAux(indice, &visitados, true);
-    cout << endl;
+    ostringstream saida;
+    saida << "Fecho Transitivo Direto: ";
+    printNos(getFechoTransitivoDireto(indice), saida);
+    saida << "\n";
+    cout << saida.str();
+}
+
+// nós que alcançam o nó informado
+vector<int> Grafo::getFechoTransitivoIndireto(int indice) {
+    vector<vector<int>> *distancias = floydAux();
+    vector<int> fecho;
+    for (int i = 0; i < distancias->size(); i++) {
+        if ((*distancias)[i][indice] != INT_MAX) fecho.push_back(i);
+    }
+
+    //desalocar memória da matriz de distâncias alocada em floydAux
+    delete (distancias);
+    return fecho;
 }
 
 void Grafo::fechoTransitivoIndireto(string id) {
@@ -275,15 +543,19 @@ void Grafo::fechoTransitivoIndireto(string id) {
         return;
     }
 
-    vector<vector<int>> *distancias = floydAux();
-    cout << "Fecho Transitivo Indireto: ";
-    for (int i = 0; i < distancias->size(); i++) {
-        if ((*distancias)[i][indice] != INT_MAX) cout << nos[i]->getId() << " ";
-    }
-    cout << endl;
+    ostringstream saida;
+    saida << "Fecho Transitivo Indireto: ";
+    printNos(getFechoTransitivoIndireto(indice), saida);
+    saida << "\n";
+    cout << saida.str();
+}
 
-    //desalocar memória da matriz de distâncias alocada em floydAux
-    delete (distancias);
+// já que não lidamos com multigrafos, os vizinhos são simplesmente os destinos de todas as arestas do nó
+vector<int> Grafo::getVizinhos(int indice) {
+    vector<int> vizinhos;
+    vizinhos.reserve(nos.getArestas(indice).size());
+    for (auto aresta : nos.getArestas(indice)) vizinhos.push_back(aresta.first);
+    return vizinhos;
 }
 
 void Grafo::vizinhancaAberta(string id) {
@@ -293,16 +565,13 @@ void Grafo::vizinhancaAberta(string id) {
         return;
     }
 
-    // já que não lidamos com multigrafos, podemos simplesmente imprimir todas as arestas do nó
-    unordered_map<int, int> arestas = *(nos[indice]->getArestas());
-    if (arestas.size() == 0) {
+    vector<int> vizinhos = getVizinhos(indice);
+    if (vizinhos.size() == 0) {
         cout << "Nao ha vizinhos\n";
     } else {
-        int i = 0;
-        for (auto aresta : arestas) {
+        for (int i = 0; i < vizinhos.size(); i++) {
             if (i != 0 && i % 10 == 0) cout << "\n"; // imprimir 10 por linha
-            cout << nos[aresta.first]->getId() << " ";
-            i++;
+            cout << nos.getId(vizinhos[i]) << " ";
         }
     }
 
@@ -317,12 +586,12 @@ void Grafo::vizinhancaFechada(string id) {
     }
 
     // já que não lidamos com multigrafos, podemos simplesmente imprimir todas as arestas do nó
-    unordered_map<int, int> arestasAux = *(nos[indice]->getArestas());
+    const Adjacencia &arestasAux = nos.getArestas(indice);
     if (arestasAux.size() == 0) {
-        cout << nos[indice]->getId() << endl;
+        cout << nos.getId(indice) << endl;
     } else {
         // caso não haja laço neste nó, devemos imprimí-lo
-        if (nos[indice]->encontrarArestasComDestino(indice) == NULL) cout << nos[indice]->getId() << " ";
+        if (nos.encontrarAresta(indice, indice) == NULL) cout << nos.getId(indice) << " ";
         vizinhancaAberta(id);
     }
 }
@@ -331,63 +600,91 @@ void Grafo::printMensagemNoInexistente(string id) {
     cout << "O no de id " << id << " nao existe no grafo!\n";
 }
 
+// escreve os ids dos nós separados por espaço. Os resultados são formatados em um buffer e escritos de uma vez só
+void Grafo::printNos(const vector<int> &indices, ostream &saida) {
+    for (int i = 0; i < indices.size(); i++) saida << nos.getId(indices[i]) << " ";
+}
+
+// escreve uma aresta "(origem, destino)" por linha
+void Grafo::printArestas(const vector<pair<int, int>> &arestas, ostream &saida) {
+    for (int i = 0; i < arestas.size(); i++)
+        saida << "(" << nos.getId(arestas[i].first) << ", " << nos.getId(arestas[i].second) << ")\n";
+}
+
 #pragma endregion
 
 /*Nessa região estão desenvolvidas as funções que irão manipular(Adicionar e Excluir) uma aresta e retornar informações sobre a aresta*/
 #pragma region Manipulação e Informação de Arestas
 
-void Grafo::inserirAresta(string idOrigem, string idDestino, int peso) {
+bool Grafo::inserirAresta(string idOrigem, string idDestino, int peso) {
     int indiceOrigem = getIndexNo(idOrigem);
     if (indiceOrigem == -1) {
-        if ((indiceOrigem = adicionarNoInexistente(idOrigem)) == -1) return;
+        if ((indiceOrigem = adicionarNoInexistente(idOrigem)) == -1) return false;
     }
 
     int indiceDestino = getIndexNo(idDestino);
     if (indiceDestino == -1) {
-        if ((indiceDestino = adicionarNoInexistente(idDestino)) == -1) return;
+        if ((indiceDestino = adicionarNoInexistente(idDestino)) == -1) return false;
     }
 
-    if (nos[indiceOrigem]->encontrarArestasComDestino(indiceDestino) != NULL) {
+    if (nos.encontrarAresta(indiceOrigem, indiceDestino) != NULL) {
         cout << "Aresta ja existe no grafo!\n";
-        return;
+        return false;
     }
 
-    nos[indiceOrigem]->inserirAresta(indiceDestino, peso);
+    // as arestas de grafos não ponderados têm sempre peso 1, o que as variantes não ponderadas assumem
+    if (!isPonderado) peso = 1;
+    nos.inserirAresta(indiceOrigem, indiceDestino, peso);
     // caso não seja digrafo e não seja um laço, devemos adicionar uma aresta no nó destino também
     if (!isDigrafo && indiceOrigem != indiceDestino) {
         // a ordem origem - destino é invertida para facilitar comparações posteriormente
-        nos[indiceDestino]->inserirAresta(indiceOrigem, peso);
+        nos.inserirAresta(indiceDestino, indiceOrigem, peso);
+    }
+
+    if (agmDinamica != NULL) {
+        // em grafos não direcionados, a aresta é identificada na AGM pelo par ordenado de índices
+        if (isDigrafo || indiceOrigem <= indiceDestino) agmDinamica->inserirAresta(indiceOrigem, indiceDestino, peso);
+        else agmDinamica->inserirAresta(indiceDestino, indiceOrigem, peso);
     }
+    invalidarGrafoCompacto();
 
     cout << "\nAresta inserida com sucesso!\n";
+    return true;
 }
 
-void Grafo::excluirAresta(string idOrigem, string idDestino) {
+bool Grafo::excluirAresta(string idOrigem, string idDestino) {
     int indiceOrigem = getIndexNo(idOrigem);
 
     if (indiceOrigem == -1) {
         printMensagemNoInexistente(idOrigem);
-        return;
+        return false;
     }
 
     int indiceDestino = getIndexNo(idDestino);
 
     if (indiceDestino == -1) {
         printMensagemNoInexistente(idDestino);
-        return;
+        return false;
     }
 
     // quando é digrafo e há somente uma aresta, podemos removê-la
-    int n = nos[indiceOrigem]->removerAresta(indiceDestino);
+    int n = nos.removerAresta(indiceOrigem, indiceDestino);
 
     if (n == 0) {
         cout << "Aresta inexistente no grafo!\n";
+        return false;
     } else {
         if (!isDigrafo) {
             // quando não é digrafo e há duas arestas, podemos removê-las pois elas são equivalentes
-            nos[indiceDestino]->removerAresta(indiceOrigem);
+            nos.removerAresta(indiceDestino, indiceOrigem);
         }
+        if (agmDinamica != NULL) {
+            if (isDigrafo || indiceOrigem <= indiceDestino) agmDinamica->removerAresta(indiceOrigem, indiceDestino);
+            else agmDinamica->removerAresta(indiceDestino, indiceOrigem);
+        }
+        invalidarGrafoCompacto();
         cout << "Aresta excluida com sucesso!\n";
+        return true;
     }
 }
 
@@ -532,8 +829,34 @@ bool isInMinHeap(struct MinHeap *minHeap, int v) {
 #pragma region Caminho Mínimo
 
 // Esta função calcula de fato as distâncias de acordo com o algoritmo de Dijstrka.
-// Por utilizar minHeap para determinar o nó mais próximo, é uma função de complexidade O(ELogV)
+// Por utilizar minHeap para determinar o nó mais próximo, é uma função de complexidade O(ELogV). Em grafos não
+// ponderados, todas as arestas têm peso 1 e a ordem da busca em largura já é a ordem em que o Dijkstra fixaria os nós,
+// portanto a fila substitui o heap e a busca para ao alcançar o destino
+template<bool Ponderado>
 int Grafo::dijkstraAux(int indiceOrigem, int indiceDestino) {
+    PERFIL_ZONA("dijkstra");
+    if constexpr (!Ponderado) {
+        vector<int> distancia(nos.size(), INT_MAX);
+        vector<int> fila; // a fila é o próprio vector, percorrido pela posição atual
+        fila.reserve(nos.size());
+        distancia[indiceOrigem] = 0;
+        fila.push_back(indiceOrigem);
+        long long arestasRelaxadas = 0;
+        int atual = 0;
+        for (; atual < fila.size() && distancia[indiceDestino] == INT_MAX; atual++) {
+            int u = fila[atual];
+            for (const auto &aresta : nos.getArestas(u)) {
+                if (distancia[aresta.first] != INT_MAX) continue;
+                distancia[aresta.first] = distancia[u] + 1;
+                fila.push_back(aresta.first);
+                arestasRelaxadas++;
+            }
+        }
+        metricas.adicionar(DIJKSTRA_NOS_FIXADOS, atual);
+        metricas.adicionar(DIJKSTRA_ARESTAS_RELAXADAS, arestasRelaxadas);
+        return distancia[indiceDestino];
+    }
+
     int dist[nos.size()];      // array que conterá as distâncias partindo do nó de índice indiceOrigem para todos os outros do grafo
 
     // minHeap represents set E
@@ -553,15 +876,20 @@ int Grafo::dijkstraAux(int indiceOrigem, int indiceDestino) {
     // Inicialmente, o tamanho do minHeap é igual à quantidade de nós no grafo
     minHeap->size = nos.size();
 
+    // contagens das métricas, somadas ao registro ao fim da execução
+    long long nosFixados = 0, arestasRelaxadas = 0, operacoesHeap = 1;
+
     // Neste loop, minHeap contém todos os nós que
     // não tiveram suas distâncias mínimas finalizadas
     while (!isEmpty(minHeap)) {
 
         struct MinHeapNode *minHeapNode = extractMin(minHeap);
         int u = minHeapNode->v; // u é o índice do nó atual
+        nosFixados++;
+        operacoesHeap++;
 
         // Atualizar as distâncias mínimas de todos os adjacentes do nó de índice u
-        for (auto aresta : *nos[u]->getArestas()) {
+        for (auto aresta : nos.getArestas(u)) {
             int v = aresta.first;
 
             // caso a distância para v ainda não tenha sido finalizada (se v está no minHeap)
@@ -572,10 +900,15 @@ int Grafo::dijkstraAux(int indiceOrigem, int indiceDestino) {
 
                 // também devemos atualizar o minHeap
                 decreaseKey(minHeap, v, dist[v]);
+                arestasRelaxadas++;
+                operacoesHeap++;
             }
         }
     }
 
+    metricas.adicionar(DIJKSTRA_NOS_FIXADOS, nosFixados);
+    metricas.adicionar(DIJKSTRA_ARESTAS_RELAXADAS, arestasRelaxadas);
+    metricas.adicionar(DIJKSTRA_OPERACOES_HEAP, operacoesHeap);
     return dist[indiceDestino];
 }
 
@@ -592,11 +925,14 @@ int Grafo::dijkstra(string idOrigem, string idDestino) {
         return -1;
     }
     // Retorna a distância de indiceorigem para indiceDestino;
-    return dijkstraAux(indiceOrigem, indiceDestino);
+    if (variante == NAO_DIRECIONADO_PONDERADO || variante == DIRECIONADO_PONDERADO)
+        return dijkstraAux<true>(indiceOrigem, indiceDestino);
+    return dijkstraAux<false>(indiceOrigem, indiceDestino);
 }
 
 vector<vector<int>> *Grafo::floydAux() {
-    pair<const int, int> *arestaAux; // auxiliar que conterá a aresta do nó i ao j na primeira fase do Floyd
+    PERFIL_ZONA("floyd");
+    const pair<const int, int> *arestaAux; // auxiliar que conterá a aresta do nó i ao j na primeira fase do Floyd
     // matriz que será preenchida pelo algoritmo de Floyd. Alocada no heap para suportar grafos maiores
     vector<vector<int>> *matrizDistancia = new vector<vector<int>>(nos.size(), vector<int>(nos.size()));
 
@@ -605,7 +941,7 @@ vector<vector<int>> *Grafo::floydAux() {
         for (int j = 0; j < nos.size(); j++) {
             if (i != j) {
                 // aux recebe a aresta entre i e j (não tratamos multigrafos, como dito em aula)
-                arestaAux = nos[i]->encontrarArestasComDestino(j);
+                arestaAux = nos.encontrarAresta(i, j);
                 if (arestaAux != NULL) {
                     (*matrizDistancia)[i][j] = arestaAux->second;
                 } else {
@@ -670,54 +1006,65 @@ int Grafo::floyd(string idOrigem, string idDestino) {
 #pragma region Busca
 
 // um ponteiro para vector<bool> é usado para que todas as chamadas compartilhem do mesmo vector
-// bool print true significa que devemos imprimir os valores visitados
-void Grafo::buscaEmProfundidadeAux(int indiceOrigem, vector<bool> *visitado, bool print) {
+// os nós visitados são acrescentados a ordem, na ordem de visita, quando ordem não é nula
+// arestasVisitadas acumula o número de arestas percorridas, usado nas métricas
+void Grafo::buscaEmProfundidadeAux(int indiceOrigem, vector<bool> *visitado, vector<int> *ordem,
+                                   long long *arestasVisitadas) {
     (*visitado)[indiceOrigem] = true;
-    if (print) cout << nos[indiceOrigem]->getId() << " ";
-    unordered_map<int, int> arestas = *(nos[indiceOrigem]->getArestas());
+    if (ordem != NULL) ordem->push_back(indiceOrigem);
+    const Adjacencia &arestas = nos.getArestas(indiceOrigem);
+    *arestasVisitadas += arestas.size();
     for (auto aresta : arestas) {
         // caso o nó já tenha sido visitado, podemos continuar pois as arestas dele já estão sendo iteradas
         // caso contrário, devemos inciar a busca nele
         if (!(*visitado)[aresta.first])
-            buscaEmProfundidadeAux(aresta.first, visitado, print);
+            buscaEmProfundidadeAux(aresta.first, visitado, ordem, arestasVisitadas);
     }
 }
 
-//Busca em pronfundidade iniciando no id informado pelo usuário
-void Grafo::buscaEmProfundidade(string id) {
-    int indiceInicio = getIndexNo(id);
-    if (indiceInicio == -1) {
-        printMensagemNoInexistente(id);
-        return;
-    }
-
+// ordem de visita da busca em profundidade iniciada no nó informado, que continua pelas demais componentes
+vector<int> Grafo::ordemBuscaEmProfundidade(int indiceInicio) {
+    PERFIL_ZONA("buscaEmProfundidade");
     vector<bool> visitado(nos.size(), false);
+    vector<int> ordem;
+    ordem.reserve(nos.size());
+    long long arestasVisitadas = 0;
     // primeiro, realizamos a busca em profundidade a partir do nó informado
-    buscaEmProfundidadeAux(indiceInicio, &visitado, true);
+    buscaEmProfundidadeAux(indiceInicio, &visitado, &ordem, &arestasVisitadas);
 
     // caso o grafo não seja conectado, devemos checar e realizar a busca a partir de todas as componentes conexas
     for (int i = 0; i < nos.size(); i++) {
         if (visitado[i]) continue;  // caso o nó já tenha sido visitado, podemos pular
-        buscaEmProfundidadeAux(i, &visitado, true);
+        buscaEmProfundidadeAux(i, &visitado, &ordem, &arestasVisitadas);
     }
-
-    cout << endl;
+    metricas.adicionar(BUSCA_ARESTAS_VISITADAS, arestasVisitadas);
+    return ordem;
 }
 
-//Busca em largura iniciando no id informado pelo usuário
-void Grafo::buscaEmLargura(string id) {
+//Busca em pronfundidade iniciando no id informado pelo usuário
+void Grafo::buscaEmProfundidade(string id) {
     int indiceInicio = getIndexNo(id);
     if (indiceInicio == -1) {
         printMensagemNoInexistente(id);
         return;
     }
 
+    ostringstream saida;
+    printNos(ordemBuscaEmProfundidade(indiceInicio), saida);
+    saida << "\n";
+    cout << saida.str();
+}
+
+// ordem de visita da busca em largura iniciada no nó informado, que continua pelas demais componentes
+vector<int> Grafo::ordemBuscaEmLargura(int indiceInicio) {
+    PERFIL_ZONA("buscaEmLargura");
     queue<int> filaVisitados;
     vector<bool> visitado(nos.size(), false);
+    vector<int> ordem;
+    ordem.reserve(nos.size());
     int indice;
-    unordered_map<int, int> arestas;
+    long long arestasVisitadas = 0;
 
-    cout << "Busca em largura \n";
     // setar condições do loop para começar no indiceInicio passado
     // loop necessário para fazer com que todas as componentes sejam visitadas
     for (int i = indiceInicio; i < indiceInicio + nos.size(); i++) {
@@ -728,13 +1075,14 @@ void Grafo::buscaEmLargura(string id) {
             filaVisitados.pop();
 
             // Com o índice atual, podemos realizar a busca nas arestas
-            arestas = *(nos[indice]->getArestas());
+            const Adjacencia &arestas = nos.getArestas(indice);
 
             if (!visitado[indice]) {
-                cout << nos[indice]->getId() << " ";
+                ordem.push_back(indice);
                 visitado[indice] = true;
             }
 
+            arestasVisitadas += arestas.size();
             for (auto aresta : arestas) {
                 if (!visitado[aresta.first]) {
                     // À medida que são encontrados nós ainda não visitados, eles são adicionados à fila
@@ -743,6 +1091,22 @@ void Grafo::buscaEmLargura(string id) {
             }
         }
     }
+    metricas.adicionar(BUSCA_ARESTAS_VISITADAS, arestasVisitadas);
+    return ordem;
+}
+
+//Busca em largura iniciando no id informado pelo usuário
+void Grafo::buscaEmLargura(string id) {
+    int indiceInicio = getIndexNo(id);
+    if (indiceInicio == -1) {
+        printMensagemNoInexistente(id);
+        return;
+    }
+
+    ostringstream saida;
+    saida << "Busca em largura \n";
+    printNos(ordemBuscaEmLargura(indiceInicio), saida);
+    cout << saida.str();
 }
 
 #pragma endregion
@@ -757,7 +1121,7 @@ bool Grafo::isTrivial() {
 bool Grafo::isNulo() {
     bool result = true;
     for (int i = 0; i < nos.size(); i++) {
-        if ((*(nos[i]->getArestas())).size() != 0) {
+        if (nos.getArestas(i).size() != 0) {
             result = false;
             break;
         }
@@ -766,23 +1130,16 @@ bool Grafo::isNulo() {
 }
 
 bool Grafo::isKRegular(int k) {
-    bool result = true;
-    for (int i = 0; i < nos.size(); i++) {
-        if (nos[i]->getGrau() != k) {
-            result = false;
-            break;
-        }
-    }
-    return result;
+    const vector<int> &graus = nos.getGraus();
+    return find_if(graus.begin(), graus.end(), [k](int grau) { return grau != k; }) == graus.end();
 }
 
 bool Grafo::isCompleto() {
     vector<bool> destinos = vector<bool>(nos.size(), false);
-    unordered_map<int, int> arestas;
 
     for (int i = 0; i < nos.size(); i++) {
-        if (nos[i]->getGrau() != nos.size() - 1) return false;  // todos os nós precisam se conectar a n-1 nós
-        arestas = *(nos[i]->getArestas());
+        if (nos.getGrau(i) != nos.size() - 1) return false;  // todos os nós precisam se conectar a n-1 nós
+        const Adjacencia &arestas = nos.getArestas(i);
         for (auto aresta : arestas) {
             if (destinos[aresta.first]) return false; // caso haja aresta paralela, não é completo
             if (i == aresta.first) return false; // caso haja laço, não é completo
@@ -797,7 +1154,7 @@ bool Grafo::isCompleto() {
 bool Grafo::isEuleriano() {
     bool result = true;
     for (int i = 0; i < nos.size(); i++) {
-        if (nos[i]->getGrau() % 2 != 0) {
+        if (nos.getGrau(i) % 2 != 0) {
             // caso um nó tenha grau ímpar, o resultado é falso
             result = false;
             break;
@@ -810,7 +1167,9 @@ bool Grafo::isEuleriano() {
     // caso contrário, devemos verificar a conectividade do grafo
     // caso, após uma passada da busca em profundidade, todos os nós tenham sido visitados, o grafo é conexo
     vector<bool> visitado(nos.size(), false);
-    buscaEmProfundidadeAux(0, &visitado, false);
+    long long arestasVisitadas = 0;
+    buscaEmProfundidadeAux(0, &visitado, NULL, &arestasVisitadas);
+    metricas.adicionar(BUSCA_ARESTAS_VISITADAS, arestasVisitadas);
 
     for (int i = 0; i < visitado.size(); i++) {
         if (!visitado[i]) {
@@ -822,13 +1181,12 @@ bool Grafo::isEuleriano() {
 }
 
 bool Grafo::isMultigrafo() {
-    unordered_map<int, int> arestas; // vector
     vector<bool> destinos = vector<bool>(nos.size(),
                                          false); // vector que guarda os destinos alcançados pelas arestas do nó atual
     bool result = false; // resultado da verificação
 
     for (int i = 0; i < nos.size(); i++) {
-        arestas = *(nos[i]->getArestas());
+        const Adjacencia &arestas = nos.getArestas(i);
         for (auto aresta : arestas) {
             if (i == aresta.first) return false; // multigrafo não tem laços
 
@@ -844,12 +1202,11 @@ bool Grafo::isMultigrafo() {
 bool Grafo::isSimples() {
     vector<bool> destinos = vector<bool>(nos.size(),
                                          false); // vector que guarda os destinos alcançados pelas arestas do nó atual
-    unordered_map<int, int> arestas; // vector auxiliar para receber as arestas de cada nó dentro do loop
 
     for (int i = 0; i < nos.size(); i++) {
-        arestas = *(nos[i]->getArestas());
+        const Adjacencia &arestas = nos.getArestas(i);
         for (auto aresta : arestas) {
-            if (nos[i]->getId().compare(nos[aresta.first]->getId()) == 0)
+            if (aresta.first == i)
                 return false; // caso haja laços, não é grafo simples
             if (destinos[aresta.first]) return false; // caso haja arestas paralelas, não é grafo simples
 
@@ -864,7 +1221,7 @@ bool Grafo::isSimples() {
 void Grafo::ordemBuscaProfundidade(int indice, vector<bool> *visitado, stack<int> &pilha) {
     (*visitado)[indice] = true;
 
-    unordered_map<int, int> arestas = *(nos[indice]->getArestas());
+    const Adjacencia &arestas = nos.getArestas(indice);
     // Chamar recursivo para todas as arestas
     for (auto aresta : arestas) {
         // caso o nó já tenha sido visitado, podemos continuar pois as arestas dele já estão sendo iteradas
@@ -877,16 +1234,19 @@ void Grafo::ordemBuscaProfundidade(int indice, vector<bool> *visitado, stack<int
     pilha.push(indice);
 }
 
-int Grafo::componentesFortementeConexas() {
-    vector<string> ids; // vector contendo todos os ids dos nós do grafo para criar o grafo transposto
+// retorna a componente fortemente conexa de cada nó, numeradas a partir de 0 na ordem em que são encontradas, e guarda
+// o número de componentes em numComponentes. Quando ordem não é nula, ela recebe os nós na ordem de visita, na qual os
+// nós de uma mesma componente são consecutivos
+vector<int> Grafo::getComponentesFortementeConexas(int *numComponentes, vector<int> *ordem) {
+    PERFIL_ZONA("componentesFortementeConexas");
+    vector<string_view> ids; // vector contendo todos os ids dos nós do grafo para criar o grafo transposto
     // vector que conterá todas as arestas do grafo para criar o grafo transposto
     // inicializado de tamanho 1 para que um SEGFAULT não seja gerado ao acessar arestas.end()
     vector<tuple<int, int, int>> *arestasGeral = new vector<tuple<int, int, int>>();
 
-    unordered_map<int, int> arestas; // vector auxiliar que guarda as arestas do nó atual dentro do loop
     for (int i = 0; i < nos.size(); i++) {
-        ids.push_back(nos[i]->getId());
-        arestas = *(nos[i]->getArestas());
+        ids.push_back(nos.getId(i));
+        const Adjacencia &arestas = nos.getArestas(i);
         for (auto aresta : arestas) arestasGeral->push_back(make_tuple(i, aresta.first, aresta.second));
     }
 
@@ -895,7 +1255,10 @@ int Grafo::componentesFortementeConexas() {
 
     stack<int> pilha;
     vector<bool> visitados(nos.size(), false);
-    int componentes = 0;
+    vector<int> componente(nos.size());
+    vector<int> ordemVisita;
+    ordemVisita.reserve(nos.size());
+    *numComponentes = 0;
 
     // Primeiramente, recebemos na pilha os tempos de término dos nós na execução da busca em profundidade
     for (int i = 0; i < nos.size(); i++)
@@ -906,45 +1269,60 @@ int Grafo::componentesFortementeConexas() {
     fill(visitados.begin(), visitados.end(), false);
 
     // Agora, precisamos processar todos os nós baseado na ordem da busca contida na pilha
+    long long arestasVisitadas = 0;
     while (!pilha.empty()) {
         int v = pilha.top();
         pilha.pop();
 
-        // Imprimir a componente fortemente conexa do vértice encontrado
+        // Os nós alcançados a partir do vértice encontrado formam a sua componente fortemente conexa
         if (!visitados[v]) {
-            componentes++;
-            transposto->buscaEmProfundidadeAux(v, &visitados, true);
-            cout << endl;
+            int inicio = ordemVisita.size();
+            transposto->buscaEmProfundidadeAux(v, &visitados, &ordemVisita, &arestasVisitadas);
+            for (int i = inicio; i < ordemVisita.size(); i++) componente[ordemVisita[i]] = *numComponentes;
+            (*numComponentes)++;
         }
     }
 
+    metricas.adicionar(BUSCA_ARESTAS_VISITADAS, arestasVisitadas);
+
     // desalocar memória usada
     delete (transposto);
     delete (arestasGeral);
 
-    return componentes;
+    if (ordem != NULL) ordem->swap(ordemVisita);
+    return componente;
 }
 
 void Grafo::showComponentesFortementeConexas() {
     if (isDigrafo) {
-        cout << "Componentes fortemente conexas: \n";
-        componentesFortementeConexas();
+        int numComponentes;
+        vector<int> ordem;
+        vector<int> componente = getComponentesFortementeConexas(&numComponentes, &ordem);
+
+        // cada componente é impressa em uma linha
+        ostringstream saida;
+        saida << "Componentes fortemente conexas: \n";
+        for (int i = 0; i < ordem.size(); i++) {
+            saida << nos.getId(ordem[i]) << " ";
+            if (i + 1 == ordem.size() || componente[ordem[i + 1]] != componente[ordem[i]]) saida << "\n";
+        }
+        cout << saida.str();
     } else {
         cout << "Componentes fortemente conexas so se aplicam em grafos direcionados!\n";
     }
 }
 
 bool Grafo::isBipartido() {
+    PERFIL_ZONA("isBipartido");
     // vector que conterá as partições de cada nó
     // Os valores possíveis no vector são 3: SEM_PARTICAO, PARTICAO_A e PARTICAO_B
     vector<int> bipartido(nos.size(), SEM_PARTICAO);
-    unordered_map<int, int> arestas; // vector auxiliar para receber as arestas de cada nó dentro do loop
 
     for (int i = 0; i < nos.size(); i++) {
         // caso não tenha partição, pomos o nó na partição A
         if (bipartido[i] == SEM_PARTICAO) bipartido[i] = PARTICAO_A;
 
-        arestas = *(nos[i]->getArestas());
+        const Adjacencia &arestas = nos.getArestas(i);
 
         for (auto aresta : arestas) {
             //Caso tenha laço, o mesmo nó não pode estar em duas partições
@@ -964,6 +1342,7 @@ bool Grafo::isBipartido() {
 }
 
 void Grafo::complementar() {
+    PERFIL_ZONA("complementar");
     if (!isSimples()) {
         cout << "Nao existe grafo complementar para um grafo nao simples\n";
         return;
@@ -973,18 +1352,19 @@ void Grafo::complementar() {
     cout << "V: { ";
     for (int i = 0; i < nos.size(); i++) {
         if (i % 10 == 0) cout << endl; // imprimir 10 por linha
-        cout << nos[i]->getId() << " ";
+        cout << nos.getId(i) << " ";
     }
     cout << "}\n\nE: {";
     int count = 0;
 
     for (int i = 0; i < nos.size(); i++) {
-        for (int j = 0; j < nos.size(); j++) {
+        // em grafos não direcionados, cada par só é testado a partir do nó de menor índice
+        for (int j = isDigrafo ? 0 : i + 1; j < nos.size(); j++) {
             if (i == j) continue;
-            if (nos[i]->encontrarArestasComDestino(j) == NULL && (isDigrafo || j > i)) {
+            if (nos.encontrarAresta(i, j) == NULL) {
                 if (count % 10 == 0) cout << endl; // imprimir 10 por linha
                 count++;
-                cout << "(" << nos[i]->getId() << ", " << nos[j]->getId() << ") ";
+                cout << "(" << nos.getId(i) << ", " << nos.getId(j) << ") ";
             }
         }
     }
@@ -996,7 +1376,7 @@ void Grafo::subGrafoInduzido(set<string> listaNo) {
     // alocar vetores no heap para poderem suportar mais dados
     vector<int> *nosInduzidos = new vector<int>(listaNo.size()); // vector que conterá os índices dos nós listados
     vector<tuple<int, int, int>> *arestasInduzidas = new vector<tuple<int, int, int>>(); // vector que conterá as arestas do subgrafo induzido
-    pair<const int, int> *aresta; // vector auxiliar que conterá as arestas do nó dentro do loop
+    const pair<const int, int> *aresta; // vector auxiliar que conterá as arestas do nó dentro do loop
 
     set<string>::iterator it;
     int indiceNo, auxIndice = 0;
@@ -1013,7 +1393,7 @@ void Grafo::subGrafoInduzido(set<string> listaNo) {
     for (int i = 0; i < nosInduzidos->size(); i++) {
         for (int j = 0; j < nosInduzidos->size(); j++) {
             if (isDigrafo || (*nosInduzidos)[j] >= (*nosInduzidos)[i]) {
-                aresta = nos[(*nosInduzidos)[i]]->encontrarArestasComDestino((*nosInduzidos)[j]);
+                aresta = nos.encontrarAresta((*nosInduzidos)[i], (*nosInduzidos)[j]);
                 if (aresta != NULL)
                     arestasInduzidas->push_back(make_tuple((*nosInduzidos)[i], (*nosInduzidos)[j], aresta->second));
             }
@@ -1023,7 +1403,7 @@ void Grafo::subGrafoInduzido(set<string> listaNo) {
     cout << "\nO subgrafo induzido resultante eh G(V,E) onde:" << endl << "V = { ";
     for (int i = 0; i < nosInduzidos->size(); i++) {
         if (i != 0 && i % 10 == 0) cout << "\n"; // imprimir 10 por linha
-        cout << nos[(*nosInduzidos)[i]]->getId() + " ";
+        cout << nos.getId((*nosInduzidos)[i]) << " ";
     }
 
     cout << "}" << endl << "E = { ";
@@ -1031,8 +1411,8 @@ void Grafo::subGrafoInduzido(set<string> listaNo) {
     //string result = "";
     for (int i = 0; i < arestasInduzidas->size(); i++) {
         if (i != 0 && i % 10 == 0) cout << "\n"; // imprimir 10 por linha
-        cout << "(" << nos[get<0>((*arestasInduzidas)[i])]->getId() << " , " <<
-             nos[get<1>((*arestasInduzidas)[i])]->getId();
+        cout << "(" << nos.getId(get<0>((*arestasInduzidas)[i])) << " , " <<
+             nos.getId(get<1>((*arestasInduzidas)[i]));
         if (isPonderado) {
             cout << ", " << get<2>((*arestasInduzidas)[i]);
         }
@@ -1046,22 +1426,22 @@ void Grafo::subGrafoInduzido(set<string> listaNo) {
     delete (arestasInduzidas);
 }
 
+vector<int> Grafo::getSequenciaDeGraus() {
+    return nos.getGraus();
+}
+
 void Grafo::sequenciaDeGraus() {
-    for (int i = 0; i < nos.size(); i++) {
-        cout << nos[i]->getGrau() << " ";
+    vector<int> graus = getSequenciaDeGraus();
+    for (int i = 0; i < graus.size(); i++) {
+        cout << graus[i] << " ";
     }
     cout << endl;
 }
 
 int Grafo::grauGrafo() {
-    int max = -1;
-    for (int i = 0; i < nos.size(); i++) {
-        if (nos[i]->getGrau() > max) {
-            max = nos[i]->getGrau();
-        }
-    }
-
-    return max;
+    const vector<int> &graus = nos.getGraus();
+    if (graus.empty()) return -1;
+    return *max_element(graus.begin(), graus.end());
 }
 
 int Grafo::ordemGrafo() {
@@ -1090,28 +1470,40 @@ int Grafo::diametroGrafo() {
     return maior;
 }
 
-void Grafo::centroGrafo() {
+vector<int> Grafo::getCentro() {
     vector<int> e = excentricidade();
     int raio = raioGrafo();
 
+    vector<int> centro;
+    for (int i = 0; i < e.size(); i++)
+        if (e[i] == raio) centro.push_back(i);
+    return centro;
+}
+
+void Grafo::centroGrafo() {
+    vector<int> centro = getCentro();
     cout << "Centro:";
-    for (int i = 0; i < e.size(); i++) {
-        if (e[i] == raio) {
-            cout << " " << nos[i]->getId();
-        }
+    for (int i = 0; i < centro.size(); i++) {
+        cout << " " << nos.getId(centro[i]);
     }
     cout << endl;
 }
 
-void Grafo::periferiaGrafo() {
+vector<int> Grafo::getPeriferia() {
     vector<int> e = excentricidade();
     int diametro = diametroGrafo();
 
+    vector<int> periferia;
+    for (int i = 0; i < e.size(); i++)
+        if (e[i] == diametro) periferia.push_back(i);
+    return periferia;
+}
+
+void Grafo::periferiaGrafo() {
+    vector<int> periferia = getPeriferia();
     cout << "Periferia:";
-    for (int i = 0; i < e.size(); i++) {
-        if (e[i] == diametro) {
-            cout << " " << nos[i]->getId();
-        }
+    for (int i = 0; i < periferia.size(); i++) {
+        cout << " " << nos.getId(periferia[i]);
     }
     cout << endl;
 }
@@ -1123,38 +1515,33 @@ void Grafo::periferiaGrafo() {
 // vector min é o nó que guarda a "alcançabilidade" do grafo. 
 // O valor min[v] indica o nó descoberto mais cedo na árvore que é alcançável pela subárvore de raiz v
 // vector pai guarda os pais dos nós
-// bool existe é uma variável auxiliar para imprimir a mensagem correta no método showArestasPonte()
+// int tempo é o último tempo de descoberta usado, compartilhado por todas as chamadas de uma mesma busca
+// vector pontes recebe as arestas ponte encontradas
 // algoritmo retirado de: http://www.geeksforgeeks.org/bridge-in-a-graph/
 void
 Grafo::arestasPonteAux(int atual, vector<bool> *visitado, vector<int> *descoberta, vector<int> *min, vector<int> *pai,
-                       bool *existe) {
-    // variável estática que determina o tempo de descoberta
-    static int tempo = 0;
-
+                       int *tempo, vector<pair<int, int>> *pontes) {
     // Marca o nó atual como visitado
     (*visitado)[atual] = true;
 
     // Inicializa o tempo de descoberta e min
-    (*descoberta)[atual] = (*min)[atual] = ++tempo;
+    (*descoberta)[atual] = (*min)[atual] = ++(*tempo);
 
     // Percorrer todas as arestas do nó atual
-    unordered_map<int, int> arestas = *(nos[atual]->getArestas());
+    const Adjacencia &arestas = nos.getArestas(atual);
     for (auto aresta : arestas) {
         int adjacente = aresta.first;
         // Caso o adjacente não tenha sido visitado
         if (!(*visitado)[adjacente]) {
             (*pai)[adjacente] = atual;
-            arestasPonteAux(adjacente, visitado, descoberta, min, pai, existe);
+            arestasPonteAux(adjacente, visitado, descoberta, min, pai, tempo, pontes);
 
             // Checar se algum filho do adjacente tem conexão com u ou um ancestral de u
             if ((*min)[adjacente] < (*min)[atual]) (*min)[atual] = (*min)[adjacente];
 
             // Se o vértice descoberto mais cedo alcançável da subárvore abaixo do adjacente
             // está abaixo do nó atual, a aresta em questão é ponte
-            if ((*min)[adjacente] > (*descoberta)[atual]) {
-                cout << "(" << nos[atual]->getId() << ", " << nos[adjacente]->getId() << ")\n";
-                *existe = true;
-            }
+            if ((*min)[adjacente] > (*descoberta)[atual]) pontes->push_back(make_pair(atual, adjacente));
 
         }
 
@@ -1164,22 +1551,31 @@ Grafo::arestasPonteAux(int atual, vector<bool> *visitado, vector<int> *descobert
     }
 }
 
-void Grafo::showArestasPonte() {
+vector<pair<int, int>> Grafo::getArestasPonte() {
+    PERFIL_ZONA("arestasPonte");
     // Inicializar os vetores necessários para chamar o método auxiliar que descobre as arestas pontes
     vector<bool> visitado(nos.size(), false);
     vector<int> descoberta(nos.size());
     vector<int> min(nos.size());
     vector<int> pai(nos.size(), -1);
+    int tempo = 0;
 
-    cout << "Arestas Ponte:\n";
-    bool arestaPonteExiste = false;
+    vector<pair<int, int>> pontes;
     // Chamar a função auxiliar recursiva para encontrar as arestas ponte
     // na árvore gerada pela busca em profundidade com raiz em i
     for (int i = 0; i < nos.size(); i++)
         if (!visitado[i])
-            arestasPonteAux(i, &visitado, &descoberta, &min, &pai, &arestaPonteExiste);
+            arestasPonteAux(i, &visitado, &descoberta, &min, &pai, &tempo, &pontes);
+    return pontes;
+}
 
-    if (!arestaPonteExiste) cout << "Nao ha arestas ponte\n";
+void Grafo::showArestasPonte() {
+    vector<pair<int, int>> pontes = getArestasPonte();
+    ostringstream saida;
+    saida << "Arestas Ponte:\n";
+    printArestas(pontes, saida);
+    if (pontes.empty()) saida << "Nao ha arestas ponte\n";
+    cout << saida.str();
 }
 
 //método auxiliar que encontra os nós de articulação. O algoritmo faz uma busca em profundidade no grafo e, a partir da árvore criada,
@@ -1190,14 +1586,12 @@ void Grafo::showArestasPonte() {
 // vector min é o nó que guarda a "alcançabilidade" do grafo. 
 // O valor min[v] indica o nó descoberto mais cedo na árvore que é alcançável pela subárvore de raiz v
 // vector pai guarda os pais dos nós
-// bool existe é uma variável auxiliar para imprimir a mensagem correta no método showNoArticulacao()
+// int tempo é o último tempo de descoberta usado, compartilhado por todas as chamadas de uma mesma busca
+// vector articulacao marca os nós de articulação encontrados
 // algoritmo retirado de: http://www.geeksforgeeks.org/articulation-points-or-cut-vertices-in-a-graph/
 void
 Grafo::noArticulacaoAux(int atual, vector<bool> *visitado, vector<int> *descoberta, vector<int> *min, vector<int> *pai,
-                        bool *existe) {
-    // variável estática que determina o tempo de descoberta
-    static int tempo = 0;
-
+                        int *tempo, vector<bool> *articulacao) {
     // Número de filhos do nó atual na árvore gerada pela busca em profundidade
     int filhos = 0;
 
@@ -1205,10 +1599,10 @@ Grafo::noArticulacaoAux(int atual, vector<bool> *visitado, vector<int> *descober
     (*visitado)[atual] = true;
 
     // Seta o tempo de descoberta do nó atual e a alcançabilidade do nó
-    (*descoberta)[atual] = (*min)[atual] = ++tempo;
+    (*descoberta)[atual] = (*min)[atual] = ++(*tempo);
 
     // Percorrer todas as arestas do nó atual
-    unordered_map<int, int> arestas = *(nos[atual]->getArestas());
+    const Adjacencia &arestas = nos.getArestas(atual);
     for (auto aresta : arestas) {
         int adjacente = aresta.first;
 
@@ -1217,7 +1611,7 @@ Grafo::noArticulacaoAux(int atual, vector<bool> *visitado, vector<int> *descober
         if (!(*visitado)[adjacente]) {
             filhos++;
             (*pai)[adjacente] = atual;
-            noArticulacaoAux(adjacente, visitado, descoberta, min, pai, existe);
+            noArticulacaoAux(adjacente, visitado, descoberta, min, pai, tempo, articulacao);
 
             // Checa se um nó da subávore com raiz adjacente tem conexão com o nó atual ou algum ancestral do nó atual
             if ((*min)[adjacente] < (*min)[atual]) (*min)[atual] = (*min)[adjacente];
@@ -1225,18 +1619,12 @@ Grafo::noArticulacaoAux(int atual, vector<bool> *visitado, vector<int> *descober
             // O nó atual é de articulação nos seguintes casos
 
             // (1) O nó atual é a raiz da árvore de busca em profundidade e tem 2 ou mais filhos
-            if ((*pai)[atual] == -1 && filhos > 1) {
-                cout << nos[atual]->getId() << endl;
-                *existe = true;
-            }
+            if ((*pai)[atual] == -1 && filhos > 1) (*articulacao)[atual] = true;
 
             // (2) O nó não é raiz da árvore e a alcançabilidade de um de seus filhos
             // é maior que o tempo de descoberta do nó atual, pois este filho precisa do nó atual
             // para se comunicar com os ancestrais do nó atual
-            if ((*pai)[atual] != -1 && (*min)[adjacente] >= (*descoberta)[atual]) {
-                cout << nos[atual]->getId() << endl;
-                *existe = true;
-            }
+            if ((*pai)[atual] != -1 && (*min)[adjacente] >= (*descoberta)[atual]) (*articulacao)[atual] = true;
         }
 
             // Atualiza a alcançabilidade do nó atual para as demais chamadas recursivas
@@ -1245,7 +1633,8 @@ Grafo::noArticulacaoAux(int atual, vector<bool> *visitado, vector<int> *descober
     }
 }
 
-void Grafo::showNoArticulacao() {
+vector<int> Grafo::getNosArticulacao() {
+    PERFIL_ZONA("nosArticulacao");
     // Inicializar os vetores necessários para chamar o método auxiliar que descobre as arestas pontes
     vector<bool> visitado(nos.size(), false);
     vector<int> descoberta(nos.size());
@@ -1253,18 +1642,31 @@ void Grafo::showNoArticulacao() {
     vector<int> pai(nos.size(),
                     -1); // valor inicializado com -1 para ser usado dentro do método auxiliar para detectar a raiz da árvore gerada pela busca em profundidade
 
-    cout << "Nos de articulacao:\n";
-    bool noArticulacaoExiste = false;
+    int tempo = 0;
+    vector<bool> articulacao(nos.size(), false);
     // Chamar a função auxiliar recursiva para encontrar os nós de articulação
     // na árvore gerada pela busca em profundidade com raiz em i
     for (int i = 0; i < nos.size(); i++)
         if (!visitado[i])
-            noArticulacaoAux(i, &visitado, &descoberta, &min, &pai, &noArticulacaoExiste);
+            noArticulacaoAux(i, &visitado, &descoberta, &min, &pai, &tempo, &articulacao);
 
-    if (!noArticulacaoExiste) cout << "Nao ha nos de articulacao\n";
+    vector<int> nosArticulacao;
+    for (int i = 0; i < nos.size(); i++)
+        if (articulacao[i]) nosArticulacao.push_back(i);
+    return nosArticulacao;
+}
+
+void Grafo::showNoArticulacao() {
+    vector<int> nosArticulacao = getNosArticulacao();
+    ostringstream saida;
+    saida << "Nos de articulacao:\n";
+    for (int i = 0; i < nosArticulacao.size(); i++) saida << nos.getId(nosArticulacao[i]) << "\n";
+    if (nosArticulacao.empty()) saida << "Nao ha nos de articulacao\n";
+    cout << saida.str();
 }
 
 vector<int> Grafo::excentricidade() {
+    PERFIL_ZONA("excentricidade");
     vector<int> result(nos.size(), 0); // Valor mínimo para excentricidade é 0 que é o valor do nó para ele mesmo
     vector<vector<int>> *matrizDistancia = floydAux(); // matriz com caminhos mais curtos do grafo
     for (int i = 0; i < nos.size(); i++) {
@@ -1282,21 +1684,20 @@ vector<int> Grafo::excentricidade() {
 }
 
 void Grafo::printGrafo() {
-    unordered_map<int, int> arestas;
     for (int i = 0; i < nos.size(); i++) {
-        arestas = *(nos[i]->getArestas());
-        cout << "No " << nos[i]->getId() << ":  ";
+        const Adjacencia &arestas = nos.getArestas(i);
+        cout << "No " << nos.getId(i) << ":  ";
 
         int lineCount = 0;
         for (auto aresta : arestas) {
             if (isPonderado) {
                 // caso seja ponderado, é necessário mostrar os pesos
                 if (lineCount != 0 && lineCount % 10 == 0) cout << "\n"; // imprimir 10 por linha
-                cout << "(" << nos[aresta.first]->getId() << ", " << aresta.second << ") ";
+                cout << "(" << nos.getId(aresta.first) << ", " << aresta.second << ") ";
             } else {
                 // caso contrário, somente mostrar os destinos das arestas
                 if (lineCount != 0 && lineCount % 20 == 0) cout << "\n"; // imprimir 10 por linha
-                cout << nos[aresta.first]->getId() << " ";
+                cout << nos.getId(aresta.first) << " ";
             }
             lineCount++;
         }
@@ -1348,13 +1749,14 @@ struct TupleCompare {
     }
 };
 
-//Algoritmo de Kruskal auxiliar para cálculo da AGM
-int Grafo::kruskalAux() {
+//Algoritmo de Kruskal auxiliar para cálculo da AGM. As arestas escolhidas são acrescentadas a arestasAGM
+int Grafo::kruskalAux(vector<pair<int, int>> *arestasAGM) {
+    PERFIL_ZONA("kruskal");
     int pesoTotal = 0;
 
     vector<tuple<int, int, int>> arestasGeral; // vector que conterá todas as arestas do grafo
     for (int i = 0; i < nos.size(); i++)
-        for (auto aresta : (*nos[i]->getArestas()))
+        for (auto aresta : nos.getArestas(i))
             arestasGeral.insert(arestasGeral.end(), make_tuple(i, aresta.first, aresta.second));
 
     // ordena as arestas baseadas em seu peso
@@ -1373,7 +1775,7 @@ int Grafo::kruskalAux() {
         // Ciclo é criado se u e v são do mesmo set
         if (set_u != set_v) {
             // Aresta atual pertence à AGM
-            cout << "(" << nos[u]->getId() << ", " << nos[v]->getId() << ")" << endl;
+            arestasAGM->push_back(make_pair(u, v));
             pesoTotal += get<2>(arestasGeral[i]);
             // Unir os 2 sets
             sd.merge(set_u, set_v);
@@ -1383,278 +1785,899 @@ int Grafo::kruskalAux() {
     return pesoTotal;
 }
 
-void Grafo::showArvoreGeradoraMinima() {
-    cout << "As arestas formadoras da AGM sao: \n";
-    int peso = kruskalAux();
-    cout << "\nPeso da AGM eh " << peso << endl;
-}
+// Algoritmo de Boruvka auxiliar para cálculo da AGM. A cada rodada, todas as componentes escolhem, em paralelo, sua
+// aresta de saída mais leve. Em seguida, as componentes são contraídas pelo set disjunto e as arestas internas
+// às componentes são descartadas, de forma que a próxima rodada só percorra arestas que ainda podem entrar na AGM.
+// Em grafos desconexos, o resultado é a floresta geradora mínima. As arestas escolhidas são acrescentadas a arestasAGM
+int Grafo::boruvkaAux(vector<pair<int, int>> *arestasAGM) {
+    PERFIL_ZONA("boruvka");
+    int pesoTotal = 0;
 
-#pragma endregion
+    vector<tuple<int, int, int>> arestasGeral; // vector que conterá todas as arestas do grafo
+    // laços nunca fazem parte da AGM
+    paraCadaAresta([&arestasGeral](int origem, int destino, int peso) {
+        if (origem != destino) arestasGeral.push_back(make_tuple(origem, destino, peso));
+    });
 
-#pragma region Coberta Mínima de Vérticas Ponderados
+    SetDisjunto sd(nos.size());
+    vector<int> componente(nos.size());
+    while (!arestasGeral.empty()) {
+        for (int v = 0; v < nos.size(); v++) componente[v] = sd.acharPai(v);
+
+        // para grafos pequenos, o custo de criar as threads supera o ganho
+        int threadsRodada = arestasGeral.size() < LIMIAR_BORUVKA_PARALELO ? 1 : getPool()->getNumThreads();
+        size_t tamBloco = (arestasGeral.size() + threadsRodada - 1) / threadsRodada;
+
+        // cada bloco de arestas guarda, para cada componente, a posição da aresta mais leve encontrada nele.
+        // O empate é desfeito pela posição da aresta no vector, o que torna a escolha determinística e garante que
+        // nenhuma rodada crie ciclos
+        vector<vector<int>> menorPorThread(threadsRodada, vector<int>(nos.size(), -1));
+        auto buscarMenores = [&](int t, int) {
+            vector<int> &menor = menorPorThread[t];
+            size_t fim = min(arestasGeral.size(), (t + 1) * tamBloco);
+            for (size_t i = t * tamBloco; i < fim; i++) {
+                int cu = componente[get<0>(arestasGeral[i])];
+                int cv = componente[get<1>(arestasGeral[i])];
+                if (cu == cv) continue;
+                if (menor[cu] == -1 || get<2>(arestasGeral[i]) < get<2>(arestasGeral[menor[cu]])) menor[cu] = i;
+                if (menor[cv] == -1 || get<2>(arestasGeral[i]) < get<2>(arestasGeral[menor[cv]])) menor[cv] = i;
+            }
+        };
+        if (threadsRodada == 1) buscarMenores(0, 0);
+        else getPool()->paraCada(threadsRodada, buscarMenores);
+
+        // combinamos os resultados das threads e contraímos as componentes. Como os blocos estão em ordem crescente
+        // de posição, manter a primeira aresta em caso de empate preserva o critério de desempate
+        bool contraiu = false;
+        for (int c = 0; c < nos.size(); c++) {
+            int escolhida = -1;
+            for (int t = 0; t < threadsRodada; t++) {
+                int candidata = menorPorThread[t][c];
+                if (candidata != -1 &&
+                    (escolhida == -1 || get<2>(arestasGeral[candidata]) < get<2>(arestasGeral[escolhida])))
+                    escolhida = candidata;
+            }
+            if (escolhida == -1) continue;
+
+            int u = get<0>(arestasGeral[escolhida]);
+            int v = get<1>(arestasGeral[escolhida]);
+            // duas componentes podem ter escolhido a mesma aresta. Neste caso, ela só deve ser adicionada uma vez
+            if (sd.acharPai(u) != sd.acharPai(v)) {
+                arestasAGM->push_back(make_pair(u, v));
+                pesoTotal += get<2>(arestasGeral[escolhida]);
+                sd.merge(u, v);
+                contraiu = true;
+            }
+        }
 
-void Grafo::showCoberturaGuloso() {
-    pair<vector<No *>, int> solucao = construirSolucao(0.0f);
+        // quando nenhuma componente tem aresta de saída, a floresta geradora mínima está completa
+        if (!contraiu) break;
 
-    cout << "Solucao encontrada pelo algoritmo guloso:\nS = {";
-    for (int i = 0; i < solucao.first.size(); ++i) {
-        if (i == 0) cout << solucao.first[i]->getId();
-        else if (i % 20 == 0) cout << "\n" << solucao.first[i]->getId(); // imprime 20 por linha
-        else cout << ", " << solucao.first[i]->getId();
+        // compactamos as arestas, removendo as internas às componentes. remove_if preserva a ordem relativa das
+        // arestas restantes, mantendo o critério de desempate consistente entre as rodadas
+        arestasGeral.erase(remove_if(arestasGeral.begin(), arestasGeral.end(), [&sd](const tuple<int, int, int> &a) {
+            return sd.acharPai(get<0>(a)) == sd.acharPai(get<1>(a));
+        }), arestasGeral.end());
     }
 
-    cout << "}\n\nPeso Total: " << solucao.second << "\n";
+    return pesoTotal;
+}
+
+// constrói a AGM mantida dinamicamente a partir das arestas atuais do grafo
+void Grafo::construirAGMDinamica() {
+    PERFIL_ZONA("construirAGMDinamica");
+    delete (agmDinamica);
+    agmDinamica = new FlorestaDinamica(nos.size());
+    FlorestaDinamica *agm = agmDinamica;
+    paraCadaAresta([agm](int origem, int destino, int peso) { agm->inserirAresta(origem, destino, peso); });
 }
 
-void Grafo::showCoberturaGulosoRandomizado(double alpha, int numIteracoes) {
-    pair<vector<No *>, int> melhorSolucao = construirSolucaoRandomizada(alpha, numIteracoes);
+void Grafo::setManterAGM(bool manter) {
+    if (manter && agmDinamica == NULL) {
+        construirAGMDinamica();
+    } else if (!manter) {
+        delete (agmDinamica);
+        agmDinamica = NULL;
+    }
+}
 
-    cout << "Solucao encontrada pelo algoritmo guloso randomizado:\nS = {";
-    for (int i = 0; i < melhorSolucao.first.size(); ++i) {
-        if (i == 0) cout << melhorSolucao.first[i]->getId();
-        else if (i % 20 == 0) cout << "\n" << melhorSolucao.first[i]->getId(); // imprime 20 por linha
-        else cout << ", " << melhorSolucao.first[i]->getId();
+void Grafo::showArvoreGeradoraMinima(bool usarBoruvka) {
+    vector<pair<int, int>> arestasAGM;
+    int peso;
+    if (agmDinamica != NULL) {
+        // quando a AGM é mantida a cada edição, basta imprimi-la, sem recalculá-la
+        vector<tuple<int, int, int>> arestasDinamica = agmDinamica->getArestas();
+        for (int i = 0; i < arestasDinamica.size(); i++)
+            arestasAGM.push_back(make_pair(get<0>(arestasDinamica[i]), get<1>(arestasDinamica[i])));
+        peso = agmDinamica->getPesoTotal();
+    } else {
+        peso = arvoreGeradoraMinima(usarBoruvka, &arestasAGM);
     }
 
-    cout << "}\n\nPeso Total: " << melhorSolucao.second << "\n";
+    ostringstream saida;
+    saida << "As arestas formadoras da AGM sao: \n";
+    printArestas(arestasAGM, saida);
+    saida << "\nPeso da AGM eh " << peso << "\n";
+    cout << saida.str();
 }
 
-struct alphaProb {
-    float prob;
-    float alpha;
-};
+// calcula a AGM pelo algoritmo escolhido, guardando as suas arestas em arestasAGM, e retorna o seu peso
+int Grafo::arvoreGeradoraMinima(bool usarBoruvka, vector<pair<int, int>> *arestasAGM) {
+    return usarBoruvka ? boruvkaAux(arestasAGM) : kruskalAux(arestasAGM);
+}
 
-void Grafo::showCoberturaGulosoRandomizadoReativo(int numIteracoes, int blocoIteracoes) {
-    float alphaVal;
-    int indiceEscolhido = 0;
+int Grafo::pesoArvoreGeradoraMinima(bool usarBoruvka) {
+    vector<pair<int, int>> arestasAGM;
+    return arvoreGeradoraMinima(usarBoruvka, &arestasAGM);
+}
 
-    vector<alphaProb> alphaProbs(TAM_REATIVO);
-    vector<float> media(TAM_REATIVO);
-    vector<int> totalSolucao(TAM_REATIVO, 0);
-    vector<int> totalChamada(TAM_REATIVO, 0);
-    vector<float> q(TAM_REATIVO);
+#pragma endregion
 
-    for (int i = 0; i < TAM_REATIVO; i++) {
-        alphaProbs[i].alpha = 0.1f * (i + 1);
-        alphaProbs[i].prob = 1.0f / TAM_REATIVO;
+#pragma region Coberta Mínima de Vérticas Ponderados
+
+// Heap de máximo indexado com os nós candidatos a entrar na solução de cobertura. A prioridade de um nó é a razão
+// entre o seu grau relevante (número de arestas ainda não atendidas) e o seu peso. Como o heap guarda a posição de
+// cada nó, o grau relevante de um nó pode ser decrementado em O(logV) sem reordenar todos os candidatos
+struct HeapCandidatos {
+    vector<int> heap; // índices dos nós ordenados pela prioridade
+    vector<int> pos; // posição de cada nó no heap, -1 quando o nó não está no heap
+    vector<int> grauRelevante;
+    vector<long long> peso;
+    int comGrauRelevante = 0; // quantidade de nós no heap com grau relevante positivo
+    long long trocas = 0; // trocas de posição no heap desde a última reinicialização, usadas nas métricas
+    long long atualizacoesGrau = 0; // decrementos de grau relevante desde a última reinicialização
+
+    // preenche o heap com todos os nós do grafo. Os vectors só são realocados quando o grafo cresce, o que permite
+    // reaproveitar o mesmo heap em várias construções
+    void reiniciar(GrafoCompacto *g) {
+        int n = g->getNumNos();
+        grauRelevante.resize(n);
+        peso.resize(n);
+        pos.resize(n);
+        heap.resize(n);
+        comGrauRelevante = 0;
+        trocas = 0;
+        atualizacoesGrau = 0;
+
+        for (int i = 0; i < n; i++) {
+            grauRelevante[i] = g->getGrau(i);
+            peso[i] = g->getPeso(i);
+            heap[i] = i;
+            pos[i] = i;
+            if (grauRelevante[i] > 0) comGrauRelevante++;
+        }
+        for (int i = n / 2 - 1; i >= 0; i--) descer(i);
     }
 
-    pair<vector<No *>, int> solucao, melhorSolucao;
+    // true -> nó a tem prioridade sobre o nó b
+    bool melhor(int a, int b) {
+        if (peso[a] == 0) {
+            // caso ambos os pesos dos nós forem 0, o de maior grau relevante é melhor
+            if (peso[b] == 0) {
+                if (grauRelevante[a] != grauRelevante[b]) return grauRelevante[a] > grauRelevante[b];
+                return a < b;
+            }
 
-    // a princípio, o custo da melhor solução é infinito
-    melhorSolucao.second = INT_MAX;
+            // caso o peso de b não for 0 e o de a é 0, a é melhor quando adiciona alguma aresta não atendida
+            return grauRelevante[a] != 0;
+        }
 
-    // usado na randomização para determinar qual alpha será escolhido
-    default_random_engine generator((unsigned int) time(0));
+        // caso o peso de b seja 0 e o de a não, b é melhor se e somente se ainda tiver grau relevante
+        if (peso[b] == 0) return grauRelevante[b] == 0;
 
-    for (int i = 0; i < TAM_REATIVO; ++i) {
-        // a cada blocoIteracoes iterações, devemos atualizar os vetores q e as probabilidades
-        if (i % blocoIteracoes == 0) {
-            // atualizamos o vetor q
-            for (int j = 0; j < TAM_REATIVO; ++j) {
-                q[j] = melhorSolucao.second / media[j];
-            }
+        // caso ambos os pesos sejam positivos, comparamos as razões grau relevante / peso. A multiplicação cruzada
+        // evita os erros de arredondamento da divisão em ponto flutuante
+        long long importanciaA = grauRelevante[a] * peso[b];
+        long long importanciaB = grauRelevante[b] * peso[a];
+        if (importanciaA != importanciaB) return importanciaA > importanciaB;
 
-            // calculamos a soma dos valores do vetor q
-            float qSum = 0.0f;
-            for (int j = 0; j < TAM_REATIVO; ++j) qSum += q[j];
+        // em caso de empate, o nó de maior grau relevante e, depois, o de menor índice é escolhido, o que torna a
+        // construção determinística
+        if (grauRelevante[a] != grauRelevante[b]) return grauRelevante[a] > grauRelevante[b];
+        return a < b;
+    }
 
-            // atualizamos as probabilidades
-            for (int j = 0; j < TAM_REATIVO; ++j) {
-                alphaProbs[j].prob = q[j] / qSum;
-            }
-        }
+    void trocar(int i, int j) {
+        trocas++;
+        swap(heap[i], heap[j]);
+        pos[heap[i]] = i;
+        pos[heap[j]] = j;
+    }
 
-        // é gerado o valor escolhido para decidirmos o valor alpha
-        // como não se pode usar o uniform_int_distribution com floats diretamente, usamos um int de 0 a 100
-        // e depois dividimos por 100 para obter o mesmo efeito
-        uniform_int_distribution<int> distr(0, 100);
-        float escolhido = (float) distr(generator) / 100;
+    void subir(int i) {
+        while (i > 0 && melhor(heap[i], heap[(i - 1) / 2])) {
+            trocar(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
 
-        for (int j = 0; j < TAM_REATIVO; ++j) {
-            // o valor das probabilidades é subtraído do valor escolhido até chegarmos a um valor negativo.
-            // Então, caso escolhido seja negativo ou zero, ele caiu na faixa de probabilidades, prob[i] é selecionado
-            escolhido -= alphaProbs[j].prob;
-            if (escolhido <= 0) {
-                indiceEscolhido = j;
-                break;
-            }
+    void descer(int i) {
+        while (true) {
+            int maior = i, esq = 2 * i + 1, dir = 2 * i + 2;
+            if (esq < heap.size() && melhor(heap[esq], heap[maior])) maior = esq;
+            if (dir < heap.size() && melhor(heap[dir], heap[maior])) maior = dir;
+            if (maior == i) return;
+            trocar(i, maior);
+            i = maior;
         }
+    }
 
-        alphaVal = alphaProbs[indiceEscolhido].alpha;
+    int tamanho() { return heap.size(); }
 
-        solucao = construirSolucaoRandomizada(alphaVal, numIteracoes / TAM_REATIVO);
+    // retorna o nó que ocuparia a posição k caso os candidatos fossem ordenados por prioridade (k = 0 é o topo).
+    // Os nós são extraídos em ordem de uma fronteira auxiliar de posições do heap, o que custa O(kLogk)
+    int kEsimo(int k) {
+        if (k == 0) return heap[0];
 
-        // caso a solução seja melhor do que a anterior, atualizamos a melhor solução
-        if (solucao.second < melhorSolucao.second) {
-            melhorSolucao = solucao;
+        auto piorPosicao = [this](int i, int j) { return melhor(heap[j], heap[i]); };
+        priority_queue<int, vector<int>, decltype(piorPosicao)> fronteira(piorPosicao);
+        fronteira.push(0);
+        while (true) {
+            int i = fronteira.top();
+            fronteira.pop();
+            if (k-- == 0) return heap[i];
+            if (2 * i + 1 < heap.size()) fronteira.push(2 * i + 1);
+            if (2 * i + 2 < heap.size()) fronteira.push(2 * i + 2);
         }
+    }
 
-        // atualizamos também os vetores contendo a media e os vetores relacionados
-        ++totalChamada[indiceEscolhido];
-        totalSolucao[indiceEscolhido] += solucao.second;
-        media[indiceEscolhido] = totalSolucao[indiceEscolhido] / totalChamada[indiceEscolhido];
-
-        if (i % 5 == 0) {
-            cout << i << " iteraçoes concluidas\n";
+    void remover(int v) {
+        int i = pos[v];
+        if (grauRelevante[v] > 0) comGrauRelevante--;
+        trocar(i, heap.size() - 1);
+        heap.pop_back();
+        pos[v] = -1;
+        if (i < heap.size()) {
+            subir(i);
+            descer(i);
         }
     }
 
-    cout << "Solucao encontrada pelo algoritmo guloso randomizado reativo:\nS = {";
-    for (int i = 0; i < melhorSolucao.first.size(); ++i) {
-        if (i == 0) cout << melhorSolucao.first[i]->getId();
-        else if (i % 20 == 0) cout << "\n" << melhorSolucao.first[i]->getId(); // imprime 20 por linha
-        else cout << ", " << melhorSolucao.first[i]->getId();
+    // um nó que perde uma aresta relevante só pode perder prioridade, portanto basta descê-lo no heap
+    void decrementarGrau(int v) {
+        atualizacoesGrau++;
+        if (grauRelevante[v]-- == 1 && pos[v] != -1) comGrauRelevante--;
+        if (pos[v] != -1) descer(pos[v]);
     }
+};
 
-    int maxChamada = 0;
-    for (int i = 0; i < TAM_REATIVO; i++) {
-        if (totalChamada[i] > maxChamada) {
-            maxChamada = i;
+// dados auxiliares de uma construção de solução. Cada thread tem o seu, para que os vectors sejam reaproveitados
+// entre as iterações sem que haja compartilhamento entre as threads
+struct EstadoConstrucao {
+    HeapCandidatos candidatos;
+    BuscaLocal buscaLocal;
+    ReligamentoCaminhos religamento;
+};
+
+// controle compartilhado por todas as iterações de uma execução do GRASP. Guarda o prazo da execução, o conjunto elite
+// usado no religamento de caminhos e a evolução da melhor solução, que é impressa a cada melhora para acompanhar o
+// progresso e ajustar os parâmetros. Os estados das threads e as soluções de cada posição do bloco também ficam no
+// controle, para que sejam reaproveitados entre os blocos de uma mesma execução
+struct ControleGrasp {
+    chrono::steady_clock::time_point inicio;
+    chrono::steady_clock::time_point prazo;
+    bool temPrazo;
+    long long limiteInferior; // quando a melhor solução atinge o limite inferior, ela é ótima e as iterações param
+    atomic<long long> melhorPeso;
+    mutex travaSaida;
+    PoolElite elite; // soluções sobre os índices do grafo reduzido
+    unordered_set<unsigned long long> vistas; // hashes das soluções que passaram recentemente pelo conjunto elite
+    queue<unsigned long long> ordemVistas; // os mesmos hashes, em ordem de chegada
+    vector<EstadoConstrucao> estados; // estado de cada thread
+    vector<SolucaoCobertura> solucoes; // solução de cada iteração do bloco atual
+    vector<SolucaoCobertura> religadas; // solução de cada religamento do bloco atual
+
+    ControleGrasp(double tempoLimite, long long limiteInferior, int numNos)
+            : melhorPeso(LLONG_MAX), elite(numNos, TAM_ELITE, max(1, numNos / DIVISOR_DISTANCIA_ELITE)) {
+        inicio = chrono::steady_clock::now();
+        temPrazo = tempoLimite > 0;
+        prazo = inicio + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(tempoLimite));
+        this->limiteInferior = limiteInferior;
+    }
+
+    bool encerrado() {
+        return melhorPeso.load(memory_order_relaxed) <= limiteInferior ||
+               (temPrazo && chrono::steady_clock::now() >= prazo);
+    }
+
+    // retorna false quando a solução já foi vista. Só os últimos MAX_SOLUCOES_VISTAS hashes são lembrados, para que
+    // as execuções longas, limitadas por tempo, não acumulem memória indefinidamente
+    bool marcarVista(unsigned long long hash) {
+        if (!vistas.insert(hash).second) return false;
+        ordemVistas.push(hash);
+        if (ordemVistas.size() > MAX_SOLUCOES_VISTAS) {
+            vistas.erase(ordemVistas.front());
+            ordemVistas.pop();
         }
+        return true;
     }
 
-    float modaAlpha = alphaProbs[maxChamada].alpha;
-    cout << "}\n\nModa Alfa: " << modaAlpha << "\n";
+    void registrarSolucao(int iteracao, long long peso) {
+        long long atual = melhorPeso.load(memory_order_relaxed);
+        while (peso < atual) {
+            if (melhorPeso.compare_exchange_weak(atual, peso, memory_order_relaxed)) {
+                double tempo = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+                lock_guard<mutex> lock(travaSaida);
+                cout << "Melhora em " << tempo << "s (iteracao " << iteracao << "): peso " << peso << "\n";
+                return;
+            }
+        }
+    }
+};
 
-    cout << "Peso Total: " << melhorSolucao.second << "\n";
+// gerador de sementes splitmix64. Sementes consecutivas geram valores independentes, o que permite derivar a
+// semente de cada iteração a partir da semente mestre e do número da iteração
+static unsigned long long splitmix64(unsigned long long x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
 }
 
-//true -> no1 primeiro
-struct comparatorNo {
-    inline bool operator()(const pair<No *, int> &no1, const pair<No *, int> &no2) {
-        if (no1.first->getPeso() == 0) {
-            // caso ambos os pesos dos nós forem 0, o de maior grau relevante é melhor
-            if (no2.first->getPeso() == 0) return no1.second > no2.second;
+// imprime os nós de uma solução de cobertura, 20 por linha
+void Grafo::printSolucaoCobertura(const vector<int> &solucao) {
+    cout << "S = {";
+    for (int i = 0; i < solucao.size(); ++i) {
+        if (i == 0) cout << nos.getId(solucao[i]);
+        else if (i % 20 == 0) cout << "\n" << nos.getId(solucao[i]); // imprime 20 por linha
+        else cout << ", " << nos.getId(solucao[i]);
+    }
+    cout << "}";
+}
+
+// imprime o tamanho do grafo reduzido em que as coberturas são construídas
+void Grafo::printReducaoCobertura() {
+    GrafoCompacto *g = getGrafoCompacto();
+    GrafoCompacto *reduzido = getKernel()->getReduzido();
+    cout << "Grafo reduzido: " << reduzido->getNumNos() << " de " << g->getNumNos() << " nos e "
+         << reduzido->getNumArestas() << " de " << g->getNumArestas() << " arestas (peso fixado: "
+         << getKernel()->getDeslocamento() << ")\n\n";
+}
+
+pair<vector<int>, long long> Grafo::construirSolucaoGulosa() {
+    PERFIL_ZONA("coberturaGulosa");
+    EstadoConstrucao estado;
+    KernelCobertura *k = getKernel();
+    SolucaoCobertura solucaoReduzida;
+    construirSolucao(0.0f, 0, k->getReduzido(), &estado, &solucaoReduzida);
+    return make_pair(k->elevar(solucaoReduzida.nos), solucaoReduzida.peso + k->getDeslocamento());
+}
+
+void Grafo::showCoberturaGuloso() {
+    pair<vector<int>, long long> solucao = construirSolucaoGulosa();
+
+    printReducaoCobertura();
+    cout << "Solucao encontrada pelo algoritmo guloso:\n";
+    printSolucaoCobertura(solucao.first);
+    cout << "\n\nPeso Total: " << solucao.second << "\n";
+    printLimiteInferior(solucao.second);
+}
+
+void Grafo::showCoberturaGulosoRandomizado(double alpha, int numIteracoes, double tempoLimite) {
+    pair<vector<int>, long long> melhorSolucao = construirSolucaoRandomizada(alpha, numIteracoes, tempoLimite);
+    if (melhorSolucao.second == LLONG_MAX) {
+        cout << "Nenhuma iteracao foi executada!\n";
+        return;
+    }
+
+    printReducaoCobertura();
+    cout << "Solucao encontrada pelo algoritmo guloso randomizado:\n";
+    printSolucaoCobertura(melhorSolucao.first);
+    cout << "\n\nPeso Total: " << melhorSolucao.second << "\n";
+    printLimiteInferior(melhorSolucao.second);
+}
+
+void Grafo::showCoberturaGulosoRandomizadoReativo(int numIteracoes, int blocoIteracoes, double tempoLimite) {
+    vector<alphaProb> alphaProbs;
+    pair<vector<int>, long long> melhorSolucao = construirSolucaoReativa(numIteracoes, blocoIteracoes,
+                                                                         tempoLimite, &alphaProbs);
+    if (melhorSolucao.second == LLONG_MAX) {
+        cout << "Nenhuma iteracao foi executada!\n";
+        return;
+    }
+
+    printReducaoCobertura();
+    cout << "Solucao encontrada pelo algoritmo guloso randomizado reativo:\n";
+    printSolucaoCobertura(melhorSolucao.first);
+
+    // a moda é o alpha escolhido mais vezes
+    int moda = 0;
+    for (int i = 0; i < alphaProbs.size(); i++) {
+        if (alphaProbs[i].totalChamada > alphaProbs[moda].totalChamada) moda = i;
+    }
+
+    cout << "\n\nAlfa\tChamadas\tMedia\t\tMelhor\tProbabilidade final\n";
+    for (int i = 0; i < alphaProbs.size(); i++) {
+        cout << alphaProbs[i].alpha << "\t" << alphaProbs[i].totalChamada << "\t\t";
+        if (alphaProbs[i].totalChamada == 0) cout << "-\t\t-";
+        else
+            cout << (double) alphaProbs[i].totalSolucao / alphaProbs[i].totalChamada << "\t\t"
+                 << alphaProbs[i].melhorSolucao;
+        cout << "\t" << alphaProbs[i].prob << "\n";
+    }
 
-            // caso o peso do no2 não for 0 e o do no1 é 0, nó1 é melhor quando adiciona alguma aresta não atendida.
-            // Portanto, caso o grau relevante de no1 seja diferente de 0, ele é melhor. Caso contrário, no2 é melhor
-            return no1.second != 0;
+    cout << "\nModa Alfa: " << alphaProbs[moda].alpha << "\n";
+    cout << "Peso Total: " << melhorSolucao.second << "\n";
+    printLimiteInferior(melhorSolucao.second);
+}
+
+// Primal-dual de Bar-Yehuda e Even: cada aresta é percorrida uma única vez e paga o menor peso residual das suas
+// pontas, que é descontado de ambas. Os nós com peso residual zero formam uma cobertura com peso no máximo duas
+// vezes o total pago, e o total pago é um limite inferior do ótimo (empacotamento de arestas). A cobertura passa
+// depois pela mesma busca local das demais construções, que só diminui o seu peso
+pair<vector<int>, long long> Grafo::construirSolucaoPrimalDual(long long *limiteEmpacotamento) {
+    PERFIL_ZONA("coberturaPrimalDual");
+    KernelCobertura *k = getKernel();
+    GrafoCompacto *g = k->getReduzido();
+    int n = g->getNumNos();
+
+    vector<long long> residual(n);
+    for (int v = 0; v < n; v++) residual[v] = g->getPeso(v);
+
+    long long pago = 0;
+    for (int v = 0; v < n; v++) {
+        for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v) && residual[v] > 0; ++u) {
+            if (*u < v) continue;
+            long long preco = min(residual[v], residual[*u]);
+            residual[v] -= preco;
+            residual[*u] -= preco;
+            pago += preco;
         }
+    }
 
-        //caso cheguemos até aqui, o peso do no2 é 0 e o do no1 não é. Portanto, podemos fazer o mesmo que acima e
-        // retornar no2 se e somente se ele ainda tiver grau relevante
-        if (no2.first->getPeso() == 0) return no2.second == 0;
+    pair<vector<int>, long long> solucao(vector<int>(), 0);
+    for (int v = 0; v < n; v++) {
+        if (residual[v] == 0) {
+            solucao.first.push_back(v);
+            solucao.second += g->getPeso(v);
+        }
+    }
 
-        // caso ambos os pesos sejam positivos, comparamos baseado no grau relevante e no peso do nó
-        // é necessário usar float para diferenciar nós candidatos de importância baixa com nós de importância nula
-        float importancia1 = (float) no1.second / no1.first->getPeso();
-        float importancia2 = (float) no2.second / no2.first->getPeso();
+    BuscaLocal buscaLocal;
+    solucao.second -= buscaLocal.melhorar(g, &solucao.first);
 
-        return importancia1 > importancia2;
+    solucao.first = k->elevar(solucao.first);
+    solucao.second += k->getDeslocamento();
+    *limiteEmpacotamento = pago + k->getDeslocamento();
+    return solucao;
+}
+
+void Grafo::showCoberturaPrimalDual() {
+    long long limiteEmpacotamento;
+    pair<vector<int>, long long> solucao = construirSolucaoPrimalDual(&limiteEmpacotamento);
+
+    printReducaoCobertura();
+    cout << "Solucao encontrada pelo algoritmo primal-dual:\n";
+    printSolucaoCobertura(solucao.first);
+    cout << "\n\nPeso Total: " << solucao.second << "\n";
+    cout << "Limite inferior (empacotamento de arestas): " << limiteEmpacotamento << "\n";
+    printLimiteInferior(solucao.second);
+}
+
+// Cobertura exata por branch-and-reduce no grafo reduzido pelo kernel. A busca parte da melhor solução de um GRASP
+// curto e só é necessária quando essa solução não atinge o limite inferior da relaxação linear. Quando tempoLimite
+// (em segundos) é positivo e a busca é interrompida no prazo, a melhor solução encontrada é exibida sem garantia
+// Retorna false, sem executar a busca, quando o grafo reduzido excede LIMITE_NOS_EXATO nós. Caso contrário, guarda a
+// melhor solução em solucao, se ela é comprovadamente ótima em otima e o tamanho da árvore de busca em nosExplorados
+bool Grafo::construirSolucaoExata(double tempoLimite, pair<vector<int>, long long> *solucao, bool *otima,
+                                  long long *nosExplorados) {
+    PERFIL_ZONA("coberturaExata");
+    KernelCobertura *k = getKernel();
+    GrafoCompacto *g = k->getReduzido();
+    if (g->getNumNos() > LIMITE_NOS_EXATO) return false;
+
+    long long limite = getLimiteInferiorCobertura();
+    ControleGrasp controle(0, limite, g->getNumNos());
+    vector<long long> pesos;
+    *solucao = executarIteracoesGrasp(0, vector<double>(ITERACOES_INCUMBENTE_EXATO, ALFA_INCUMBENTE_EXATO), &pesos,
+                                      &controle);
+
+    *otima = solucao->second == limite;
+    *nosExplorados = 0;
+    if (!*otima) {
+        PERFIL_ZONA("buscaExata");
+        CoberturaExata exata(g);
+        vector<int> solucaoReduzida;
+        long long peso;
+        *otima = exata.resolver(solucao->second - k->getDeslocamento(), getPool(), tempoLimite, &solucaoReduzida,
+                                &peso);
+        *nosExplorados = exata.getNosExplorados();
+        metricas.adicionar(COBERTURA_NOS_EXATA, *nosExplorados);
+        if (!solucaoReduzida.empty()) {
+            solucao->first = k->elevar(solucaoReduzida);
+            solucao->second = peso + k->getDeslocamento();
+        }
     }
-};
+    return true;
+}
+
+void Grafo::showCoberturaExata(double tempoLimite) {
+    pair<vector<int>, long long> solucao;
+    bool otima;
+    long long nosExplorados;
+    if (!construirSolucaoExata(tempoLimite, &solucao, &otima, &nosExplorados)) {
+        cout << "O grafo reduzido possui " << getKernel()->getReduzido()->getNumNos()
+             << " nos. A cobertura exata aceita no maximo " << LIMITE_NOS_EXATO << " nos.\n";
+        return;
+    }
+
+    printReducaoCobertura();
+    cout << "Solucao encontrada pelo algoritmo exato:\n";
+    printSolucaoCobertura(solucao.first);
+    cout << "\n\nPeso Total: " << solucao.second << "\n";
+    cout << "Nos explorados: " << nosExplorados << "\n";
+    if (otima) cout << "Solucao otima comprovada\n";
+    else {
+        cout << "Busca interrompida pelo tempo limite\n";
+        printLimiteInferior(solucao.second);
+    }
+}
+
+// Limite inferior da relaxação linear da cobertura, calculado no grafo reduzido pelo kernel. A relaxação é resolvida
+// pelo corte mínimo do grafo bipartido duplo: cada nó v vira vE e vD, com arcos fonte -> vE e vD -> sumidouro de
+// capacidade igual ao peso de v e arcos vE -> uD de capacidade infinita para cada aresta (v, u). O corte mínimo vale o
+// dobro do ótimo da relaxação, que é semi-inteiro. Como os pesos são inteiros, o ótimo inteiro é pelo menos o teto
+// da metade do corte. O limite fica guardado até a próxima edição do grafo
+long long Grafo::getLimiteInferiorCobertura() {
+    if (limiteInferior == -1) {
+        PERFIL_ZONA("limiteInferior");
+        KernelCobertura *k = getKernel();
+        GrafoCompacto *g = k->getReduzido();
+        int n = g->getNumNos();
+        int fonte = 2 * n, sumidouro = 2 * n + 1;
+
+        FluxoMaximo fluxo(2 * n + 2);
+        long long infinito = 0;
+        for (int v = 0; v < n; v++) infinito += g->getPeso(v);
+        infinito++;
+        for (int v = 0; v < n; v++) {
+            fluxo.adicionarArco(fonte, v, g->getPeso(v));
+            fluxo.adicionarArco(n + v, sumidouro, g->getPeso(v));
+            for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u)
+                fluxo.adicionarArco(v, n + *u, infinito);
+        }
+
+        long long corte = fluxo.calcular(fonte, sumidouro);
+        limiteInferior = (corte + 1) / 2 + k->getDeslocamento();
+    }
+    return limiteInferior;
+}
+
+// imprime o limite inferior da relaxação linear e a distância relativa entre ele e o peso da solução
+void Grafo::printLimiteInferior(long long peso) {
+    long long limite = getLimiteInferiorCobertura();
+    cout << "Limite inferior (relaxacao linear): " << limite << "\n";
+    if (peso == limite) cout << "Solucao otima (atinge o limite inferior)\n";
+    else if (limite > 0) cout << "Gap: " << 100.0 * (peso - limite) / limite << "%\n";
+}
+
+// GRASP reativo: a cada iteração, o alpha é sorteado de acordo com as probabilidades de cada alpha. As iterações são
+// executadas em blocos de blocoIteracoes: os alphas do bloco são sorteados, as construções do bloco são executadas em
+// paralelo e, ao fim do bloco, as probabilidades são atualizadas a partir da média das soluções de cada alpha.
+// Quando tempoLimite (em segundos) é positivo, os blocos são executados até o prazo, ignorando numIteracoes
+// Em ambos os casos, as iterações param assim que a melhor solução atinge o limite inferior da relaxação linear
+pair<vector<int>, long long> Grafo::construirSolucaoReativa(int numIteracoes, int blocoIteracoes,
+                                                            double tempoLimite, vector<alphaProb> *alphaProbs) {
+    PERFIL_ZONA("graspReativo");
+    ControleGrasp controle(tempoLimite, getLimiteInferiorCobertura(), getKernel()->getReduzido()->getNumNos());
+    if (tempoLimite > 0) numIteracoes = INT_MAX;
 
-pair<vector<No *>, int> Grafo::construirSolucaoRandomizada(double alpha, int numIteracoes) {
-    Clock *clock = new Clock("Gulosera");
+    alphaProbs->assign(TAM_REATIVO, alphaProb());
+    for (int i = 0; i < TAM_REATIVO; i++) {
+        (*alphaProbs)[i].alpha = 0.1f * (i + 1);
+        (*alphaProbs)[i].prob = 1.0f / TAM_REATIVO;
+    }
 
-    //auxiliar para mostrar progresso na interface
-    int k = 0;
-    pair<vector<No *>, int> solucao, melhorSolucao;
+    pair<vector<int>, long long> melhorSolucao;
 
     // a princípio, o custo da melhor solução é infinito
-    melhorSolucao.second = INT_MAX;
+    melhorSolucao.second = LLONG_MAX;
+
+    // usado na randomização para determinar qual alpha será escolhido. A semente é derivada da semente mestre para
+    // que a sequência de alphas não coincida com as sementes das construções
+    default_random_engine generator((unsigned int) splitmix64(~semente));
+
+    // o primeiro bloco sempre é executado, pois contém a iteração 0, que garante uma cobertura
+    for (int inicio = 0; inicio < numIteracoes && (inicio == 0 || !controle.encerrado()); inicio += blocoIteracoes) {
+        int tamBloco = min(blocoIteracoes, numIteracoes - inicio);
+
+        // sorteamos os alphas de todas as iterações do bloco de acordo com as probabilidades atuais
+        vector<double> probs(TAM_REATIVO);
+        for (int j = 0; j < TAM_REATIVO; ++j) probs[j] = (*alphaProbs)[j].prob;
+        discrete_distribution<int> distr(probs.begin(), probs.end());
+
+        vector<int> indicesEscolhidos(tamBloco);
+        vector<double> alphas(tamBloco);
+        for (int i = 0; i < tamBloco; ++i) {
+            indicesEscolhidos[i] = distr(generator);
+            alphas[i] = (*alphaProbs)[indicesEscolhidos[i]].alpha;
+        }
 
-    // caso o alpha passado seja zero, podemos fazer uma única iteração pois o resultado não mudará (equivalente ao guloso comum)
-    if (alpha == 0) numIteracoes = 1;
+        vector<long long> pesos;
+        pair<vector<int>, long long> melhorBloco = executarIteracoesGrasp(inicio, alphas, &pesos, &controle);
 
-    for (int i = 0; i < numIteracoes; ++i) {
-        solucao = construirSolucao(alpha);
-        if (solucao.second < melhorSolucao.second) {
-            melhorSolucao = solucao;
+        // caso a solução seja melhor do que a anterior, atualizamos a melhor solução. Como os blocos são processados em
+        // ordem, manter a anterior em caso de empate equivale a desempatar pela iteração
+        if (melhorBloco.second < melhorSolucao.second) melhorSolucao = move(melhorBloco);
+
+        // atualizamos também os dados de cada alpha. Iterações não executadas por causa do prazo são ignoradas
+        for (int i = 0; i < tamBloco; ++i) {
+            if (pesos[i] == -1) continue;
+            alphaProb &escolhido = (*alphaProbs)[indicesEscolhidos[i]];
+            ++escolhido.totalChamada;
+            escolhido.totalSolucao += pesos[i];
+            if (pesos[i] < escolhido.melhorSolucao) escolhido.melhorSolucao = pesos[i];
         }
-        //atualizar auxiliar que mostra informações na interface
-        ++k;
-        if (k % 5 == 0) {
-            cout << k << " iteraçoes concluidas\n";
+
+        // atualizamos o vetor q: quanto menor a média das soluções de um alpha em relação à melhor solução, maior o
+        // seu q. O expoente amplifica as diferenças entre os alphas. Os alphas ainda não sorteados recebem o maior q,
+        // para que continuem tendo chance de serem escolhidos
+        vector<double> q(TAM_REATIVO, 0.0);
+        double maiorQ = 0.0;
+        for (int j = 0; j < TAM_REATIVO; ++j) {
+            if ((*alphaProbs)[j].totalChamada == 0) continue;
+            double media = (double) (*alphaProbs)[j].totalSolucao / (*alphaProbs)[j].totalChamada;
+            q[j] = media > 0 ? pow(melhorSolucao.second / media, EXPOENTE_REATIVO) : 1.0;
+            maiorQ = max(maiorQ, q[j]);
+        }
+
+        // calculamos a soma dos valores do vetor q
+        double qSum = 0.0;
+        for (int j = 0; j < TAM_REATIVO; ++j) {
+            if ((*alphaProbs)[j].totalChamada == 0) q[j] = maiorQ;
+            qSum += q[j];
+        }
+
+        // atualizamos as probabilidades
+        if (qSum > 0) {
+            for (int j = 0; j < TAM_REATIVO; ++j) (*alphaProbs)[j].prob = (float) (q[j] / qSum);
         }
     }
 
-    delete (clock);
     return melhorSolucao;
 }
 
-// função auxiliar que, de fato, contruirá as soluções dos algoritmos gulosos
-pair<vector<No *>, int> Grafo::construirSolucao(double alpha) {
-    // vector que conterá os ponteiros dos nós do grafo e o grau relevante deles, isto é, o número de arestas
-    // ainda não atendidas na cobertura mínima
-    vector<pair<No *, int>> nosAux(nos.size());
+void Grafo::setSemente(unsigned long long semente) {
+    this->semente = semente;
+}
 
-    // vector que conterá todas as arestas do grafo no seguinte formato: origem, destino, atendida (na solução)
-    vector<pair<int, int>> arestasNaoAtendidas;
+void Grafo::setNumThreads(int numThreads) {
+    this->numThreads = numThreads > 0 ? numThreads : 1;
+    // o pool é recriado com o novo número de threads na próxima vez que for usado
+    delete (pool);
+    pool = NULL;
+}
 
-    for (int i = 0; i < nos.size(); i++) {
-        nosAux[i].first = nos[i];
-        nosAux[i].second = nos[i]->getGrau();
-        for (auto aresta : (*nos[i]->getArestas())) {
-            if (isDigrafo || aresta.first >= i)
-                arestasNaoAtendidas.insert(arestasNaoAtendidas.end(), make_pair(i, aresta.first));
+PoolThreads *Grafo::getPool() {
+    if (pool == NULL) pool = new PoolThreads(numThreads);
+    return pool;
+}
+
+// Quando tempoLimite (em segundos) é positivo, as iterações são executadas em blocos até o prazo, ignorando numIteracoes
+// Em ambos os casos, as iterações param assim que a melhor solução atinge o limite inferior da relaxação linear
+pair<vector<int>, long long> Grafo::construirSolucaoRandomizada(double alpha, int numIteracoes, double tempoLimite) {
+    PERFIL_ZONA("graspRandomizado");
+
+    // caso o alpha passado seja zero, podemos fazer uma única iteração pois o resultado não mudará (equivalente ao guloso comum)
+    if (alpha == 0) {
+        numIteracoes = 1;
+        tempoLimite = 0;
+    }
+
+    ControleGrasp controle(tempoLimite, getLimiteInferiorCobertura(), getKernel()->getReduzido()->getNumNos());
+    vector<long long> pesos;
+    pair<vector<int>, long long> melhorSolucao;
+
+    // Com tempo limite, os blocos são pequenos o suficiente para que o prazo seja verificado com frequência, mas com
+    // iterações suficientes para ocupar todas as threads. Sem tempo limite, o tamanho dos blocos, que determina quando
+    // ocorrem os religamentos, não depende do número de threads, para que o resultado também não dependa
+    int tamBloco = ITERACOES_ENTRE_RELIGAMENTOS;
+    if (tempoLimite > 0) {
+        tamBloco = getPool()->getNumThreads() * ITERACOES_POR_THREAD_BLOCO;
+        numIteracoes = INT_MAX;
+    }
+    melhorSolucao.second = LLONG_MAX;
+    // o primeiro bloco sempre é executado, pois contém a iteração 0, que garante uma cobertura
+    for (int inicio = 0; inicio < numIteracoes && (inicio == 0 || !controle.encerrado()); inicio += tamBloco) {
+        int iteracoesBloco = min(tamBloco, numIteracoes - inicio);
+        pair<vector<int>, long long> melhorBloco = executarIteracoesGrasp(
+                inicio, vector<double>(iteracoesBloco, alpha), &pesos, &controle);
+        if (melhorBloco.second < melhorSolucao.second) melhorSolucao = move(melhorBloco);
+    }
+
+    return melhorSolucao;
+}
+
+// Executa as iterações de inicio até inicio + alphas.size() - 1, usando alphas[i] na iteração inicio + i, e retorna a
+// melhor solução encontrada. O peso da solução de cada iteração é guardado em pesos, ou -1 caso a iteração não tenha
+// sido executada porque o prazo do controle se esgotou.
+// As construções são feitas no grafo reduzido pelo kernel. Os pesos já incluem o peso fixado pelas reduções e a
+// solução retornada é convertida para os índices do grafo original.
+// Ao fim das construções, as melhores soluções são intensificadas pelo religamento de caminhos com o conjunto elite do
+// controle, que é mantido entre as chamadas de uma mesma execução.
+// As iterações são distribuídas entre as threads do pool. A semente de cada iteração depende somente da semente mestre
+// e do número da iteração, e o empate entre soluções de mesmo peso é desfeito pelo número da iteração. Portanto, o
+// resultado é o mesmo para uma mesma semente mestre, independentemente da ordem em que as threads executam
+pair<vector<int>, long long> Grafo::executarIteracoesGrasp(int inicio, const vector<double> &alphas,
+                                                           vector<long long> *pesos, ControleGrasp *controle) {
+    PERFIL_ZONA("blocoGrasp");
+    int numIteracoes = alphas.size();
+    pesos->assign(numIteracoes, -1);
+
+    // o grafo reduzido precisa ser construído antes de ser compartilhado entre as threads
+    KernelCobertura *k = getKernel();
+    GrafoCompacto *g = k->getReduzido();
+    PoolThreads *poolGrasp = getPool();
+
+    // cada iteração constrói a sua solução na posição correspondente do bloco, cujos vectors são reaproveitados
+    if (controle->estados.size() < poolGrasp->getNumThreads()) controle->estados.resize(poolGrasp->getNumThreads());
+    if (controle->solucoes.size() < numIteracoes) controle->solucoes.resize(numIteracoes);
+    vector<SolucaoCobertura> &solucoes = controle->solucoes;
+
+    unsigned long long sementeMestre = semente;
+    poolGrasp->paraCada(numIteracoes, [&](int i, int idThread) {
+        int iteracao = inicio + i;
+        // a primeira iteração da execução sempre é feita, mesmo com o prazo esgotado, para que exista uma cobertura
+        if (iteracao > 0 && controle->encerrado()) return;
+        construirSolucao(alphas[i], (unsigned int) splitmix64(sementeMestre + iteracao), g,
+                         &controle->estados[idThread], &solucoes[i]);
+        solucoes[i].peso += k->getDeslocamento();
+        (*pesos)[i] = solucoes[i].peso;
+        controle->registrarSolucao(iteracao, (*pesos)[i]);
+    });
+
+    // a melhor solução do bloco é a de menor peso, desempatando pela iteração
+    SolucaoCobertura *melhor = NULL;
+    for (int i = 0; i < numIteracoes; i++) {
+        if ((*pesos)[i] != -1 && (melhor == NULL || (*pesos)[i] < melhor->peso)) melhor = &solucoes[i];
+    }
+
+    // as soluções do bloco tentam entrar no conjunto elite em ordem de iteração, e as que entram são religadas a uma
+    // solução elite sorteada pela semente da sua iteração. Soluções repetidas, identificadas pelo hash, são ignoradas.
+    // O conjunto só é alterado fora das tarefas paralelas, o que mantém o resultado independente da ordem em que as
+    // threads executam
+    PoolElite &elite = controle->elite;
+    vector<int> origens;
+    for (int i = 0; i < numIteracoes; i++) {
+        if ((*pesos)[i] == -1 || !controle->marcarVista(solucoes[i].hash)) continue;
+        if (elite.inserir(solucoes[i].bits, solucoes[i].peso)) origens.push_back(i);
+    }
+
+    if (elite.getTamanho() > 1) {
+        vector<int> parceiros(origens.size());
+        for (int j = 0; j < origens.size(); j++) {
+            parceiros[j] = (int) (splitmix64(~(sementeMestre + inicio + origens[j])) % elite.getTamanho());
+            if (elite.getBits(parceiros[j]) == solucoes[origens[j]].bits)
+                parceiros[j] = (parceiros[j] + 1) % elite.getTamanho();
+        }
+
+        if (controle->religadas.size() < origens.size()) controle->religadas.resize(origens.size());
+        vector<SolucaoCobertura> &religadas = controle->religadas;
+        for (int j = 0; j < origens.size(); j++) religadas[j].peso = -1;
+
+        poolGrasp->paraCada(origens.size(), [&](int j, int idThread) {
+            if (controle->encerrado()) return;
+            PERFIL_ZONA("religamento");
+            EstadoConstrucao &estado = controle->estados[idThread];
+            SolucaoCobertura &religada = religadas[j];
+            religada.reiniciar(g->getNumNos());
+            long long peso = estado.religamento.religar(g, solucoes[origens[j]].bits,
+                                                        elite.getBits(parceiros[j]), &religada.nos);
+            metricas.adicionar(COBERTURA_RELIGAMENTOS, 1);
+            if (peso == -1) return;
+            PERFIL_ZONA("buscaLocal");
+            peso -= estado.buscaLocal.melhorar(g, &religada.nos);
+            religada.recalcular();
+            religada.peso = peso + k->getDeslocamento();
+            controle->registrarSolucao(inicio + origens[j], religada.peso);
+        });
+
+        for (int j = 0; j < origens.size(); j++) {
+            if (religadas[j].peso == -1 || !controle->marcarVista(religadas[j].hash)) continue;
+            elite.inserir(religadas[j].bits, religadas[j].peso);
+            if (religadas[j].peso < melhor->peso) melhor = &religadas[j];
         }
     }
 
-    // solução é um pair consistindo do vetor de nós contidos na solução e um int que guarda o custo total da solução
-    pair<vector<No *>, int> solucao;
+    if (melhor == NULL) return make_pair(vector<int>(), LLONG_MAX);
+    return make_pair(k->elevar(melhor->nos), melhor->peso);
+}
 
-    // usado na randomização dos índices
-    default_random_engine generator((unsigned int) time(0));
+// retorna a representação compacta do grafo, construindo-a caso o grafo tenha sido editado desde a última construção
+GrafoCompacto *Grafo::getGrafoCompacto() {
+    if (compacto == NULL) {
+        PERFIL_ZONA("construirGrafoCompacto");
+        vector<pair<int, int>> arestas;
+        paraCadaAresta([&arestas](int origem, int destino, int) { arestas.push_back(make_pair(origem, destino)); });
+        compacto = new GrafoCompacto(nos.size(), arestas, pesoNos);
+    }
+    return compacto;
+}
 
-    while (arestasNaoAtendidas.size() != 0) {
-        //primeiramente, ordenamos o vetor de nós
-        sort(nosAux.begin(), nosAux.end(), comparatorNo());
+// retorna o kernel da cobertura, construído a partir da representação compacta atual
+KernelCobertura *Grafo::getKernel() {
+    if (kernel == NULL) {
+        // a representação compacta é construída fora da zona do kernel
+        GrafoCompacto *g = getGrafoCompacto();
+        PERFIL_ZONA("kernel");
+        kernel = new KernelCobertura(g);
+    }
+    return kernel;
+}
 
-        //recupera o índice do nó a ser adicionado na solução
-        int indice = 0;
+void Grafo::invalidarGrafoCompacto() {
+    // o kernel referencia a representação compacta, portanto é descartado junto com ela
+    delete (kernel);
+    kernel = NULL;
+    limiteInferior = -1;
+    delete (compacto);
+    compacto = NULL;
+}
+
+// função auxiliar que, de fato, contruirá as soluções dos algoritmos gulosos, seguida da busca local. A semente é usada
+// somente quando alpha não é zero, e os dados auxiliares são reaproveitados do estado passado
+void Grafo::construirSolucao(double alpha, unsigned int semente, GrafoCompacto *g, EstadoConstrucao *estado,
+                             SolucaoCobertura *solucao) {
+    PERFIL_ZONA("construirSolucao");
+    // o heap contém os nós do grafo com o seu grau relevante, isto é, o número de arestas
+    // ainda não atendidas na cobertura mínima
+    HeapCandidatos &candidatos = estado->candidatos;
+    candidatos.reiniciar(g);
+
+    // uma aresta está atendida se e somente se uma de suas pontas está na solução. Portanto, basta guardar quais nós
+    // estão na solução, o que o bitset da solução já faz, e quantas arestas ainda não foram atendidas
+    solucao->reiniciar(g->getNumNos());
+    int arestasNaoAtendidas = g->getNumArestas();
+
+    // usado na randomização dos índices
+    default_random_engine generator(semente);
+    long long escolhas = 0;
+
+    while (arestasNaoAtendidas != 0) {
+        //recupera a posição, na ordem de prioridade, do nó a ser adicionado na solução
+        int posicao = 0;
         if (alpha != 0) {
-            int range = (int) (alpha * nosAux.size());
-            while (nosAux[range].second == 0 && range != 0) {
-                // caso haja nós com importância 0 dentro do range de escolha randomizada, diminuir a range
-                // até achar um nó com importância (nosAux[range].second !=0) ou caso cheguemos ao começo do vetor (range == 0)
-                --range;
-            }
+            int range = min((int) (alpha * candidatos.tamanho()), candidatos.tamanho() - 1);
+            // caso haja nós com importância 0 dentro do range de escolha randomizada, diminuir a range.
+            // Como os nós sem grau relevante são os últimos na ordem de prioridade, basta limitar a range a eles
+            if (range >= candidatos.comGrauRelevante) range = max(candidatos.comGrauRelevante - 1, 0);
             uniform_int_distribution<int> distr(0, range);
-            indice = distr(generator);
+            posicao = distr(generator);
         }
+        int indice = candidatos.kEsimo(posicao);
 
         //como é guloso, escolhemos o melhor nó encontrado e atualizamos tanto a lista de nós quanto o peso total
-        solucao.first.push_back(nosAux[indice].first);
-        solucao.second += nosAux[indice].first->getPeso();
+        solucao->adicionar(indice, g->getPeso(indice));
 
-        // atualizamos as arestas, removendo as atendidas pelo nó adicionado e diminuindo o grau relevante dos
-        // nós adjacentes ao adicionado
-        atualizaNosEArestas(nosAux[indice].first, &arestasNaoAtendidas, &nosAux);
-
-        // removemos o nó adicionado à solução
-        nosAux.erase(nosAux.begin() + indice);
+        // atualizamos as arestas atendidas pelo nó adicionado e diminuímos o grau relevante dos nós adjacentes
+        atualizaNosEArestas(indice, g, estado, solucao, &arestasNaoAtendidas);
+        escolhas++;
     }
-    return solucao;
+
+    metricas.adicionar(COBERTURA_CONSTRUCOES, 1);
+    metricas.adicionar(COBERTURA_ESCOLHAS_GULOSAS, escolhas);
+    metricas.adicionar(COBERTURA_ATUALIZACOES_GRAU, candidatos.atualizacoesGrau);
+    metricas.adicionar(COBERTURA_TROCAS_HEAP, candidatos.trocas);
+
+    // por fim, a solução construída é melhorada pela busca local
+    PERFIL_ZONA("buscaLocal");
+    solucao->peso -= estado->buscaLocal.melhorar(g, &solucao->nos);
+    solucao->recalcular();
 }
 
-void
-Grafo::atualizaNosEArestas(No *noAdicionado, vector<pair<int, int>> *arestasGeral, vector<pair<No *, int>> *nosAux) {
-    vector<pair<int, int>>::iterator it;
-    int indiceNoAdicionado = idMap.find(noAdicionado->getId())->second;
-    for (it = arestasGeral->begin(); it != arestasGeral->end();) {
-        if (it->first == indiceNoAdicionado) {
-            for (int i = 0; i < nosAux->size(); ++i) {
-                if (nos[it->second]->getId() == (*nosAux)[i].first->getId()) {
-                    --(*nosAux)[i].second;
-                    break;
-                }
-            }
-            it = arestasGeral->erase(it);
-        } else if (it->second == indiceNoAdicionado) {
-            for (int i = 0; i < nosAux->size(); ++i) {
-                if (nos[it->first]->getId() == (*nosAux)[i].first->getId()) {
-                    --(*nosAux)[i].second;
-                    break;
-                }
-            }
-            it = arestasGeral->erase(it);
-        } else {
-            // como há deleções durante a iteração, é necessário realizar a incrementação aqui, para evitar
-            // exceções dentro da hashtable
-            ++it;
-        }
+// adiciona o nó à solução, percorrendo somente os seus vizinhos. Custa O(grau * logV), em vez de percorrer todas
+// as arestas ainda não atendidas
+void Grafo::atualizaNosEArestas(int indiceNoAdicionado, GrafoCompacto *g, EstadoConstrucao *estado,
+                                SolucaoCobertura *solucao, int *arestasNaoAtendidas) {
+    HeapCandidatos &candidatos = estado->candidatos;
+
+    // todas as arestas ainda não atendidas do nó adicionado passam a ser atendidas
+    *arestasNaoAtendidas -= candidatos.grauRelevante[indiceNoAdicionado];
+    candidatos.remover(indiceNoAdicionado);
+
+    // os vizinhos fora da solução perdem a aresta que os ligava ao nó adicionado
+    for (const int *v = g->vizinhosBegin(indiceNoAdicionado); v != g->vizinhosEnd(indiceNoAdicionado); ++v) {
+        if (!solucao->contem(*v)) candidatos.decrementarGrau(*v);
     }
 }
 
@@ -1663,9 +2686,10 @@ Grafo::atualizaNosEArestas(No *noAdicionado, vector<pair<int, int>> *arestasGera
 #pragma region Destrutor
 
 Grafo::~Grafo() {
-    for (int i = 0; i < nos.size(); i++) {
-        delete (nos[i]);
-    }
+    delete (agmDinamica);
+    delete (kernel);
+    delete (compacto);
+    delete (pool);
 }
 
 #pragma endregion
\ No newline at end of file
@@ -1,6 +1,19 @@
 #pragma once
-#include "No.h"
+#include "ArmazemNos.h"
 #include "Aresta.h"
+#include "FlorestaDinamica.h"
+#include "GrafoCompacto.h"
+#include "PoolThreads.h"
+#include "BuscaLocal.h"
+#include "KernelCobertura.h"
+#include "FluxoMaximo.h"
+#include "CoberturaExata.h"
+#include "PoolElite.h"
+#include "ReligamentoCaminhos.h"
+#include "SolucaoCobertura.h"
+#include "MetricasGrafo.h"
+#include "ArenaStrings.h"
+#include "TabelaIds.h"
 #include <iostream>
 #include <string>
 #include <fstream>
@@ -8,49 +21,120 @@
 #include <set>
 #include <stack>
 #include <map>
+#include <tuple>
+#include <climits>
 
 using namespace std;
 
+struct EstadoConstrucao;
+struct ControleGrasp;
+
+// dados de cada alpha do algoritmo reativo
+struct alphaProb {
+    float prob;
+    float alpha;
+    int totalChamada = 0;
+    long long totalSolucao = 0;
+    long long melhorSolucao = LLONG_MAX;
+};
+
 class Grafo
 {
 private:
-    Grafo(vector<string> ids, vector<tuple<int, int, int>>* arestas); // construtor auxiliar usado no cálculo das componentes fortemente conexas
-    vector<No*> nos;
-    map<string, int> idMap;
+    Grafo(vector<string_view> ids, vector<tuple<int, int, int>>* arestas); // construtor auxiliar usado no cálculo das componentes fortemente conexas
+    ArmazemNos nos; // id, grau e arestas de cada nó, em vectors paralelos
+    vector<long long> pesoNos; // peso de cada nó, na mesma ordem de nos, lido diretamente pela cobertura
+    ArenaStrings arenaIds; // ids de todos os nós, guardados uma única vez
+    TabelaIds idMap; // índice de cada id, com chaves apontando para a arena
+    // posição de cada nó no arquivo de entrada e índice do nó de cada posição, preenchidos somente quando os nós são
+    // reordenados. Vazios, os índices são as próprias posições
+    vector<int> posicaoArquivo;
+    vector<int> indicePorPosicao;
     bool isDigrafo = false; // assumimos que um grafo é não direcionado por padrão
     bool isPonderado = true; // assumimos que um grafo é ponderado por padrão
+    // combinação de direção e ponderação, definida ao fim da leitura, que escolhe as instanciações dos laços sobre as
+    // arestas
+    enum VarianteGrafo {
+        NAO_DIRECIONADO_NAO_PONDERADO, NAO_DIRECIONADO_PONDERADO, DIRECIONADO_NAO_PONDERADO, DIRECIONADO_PONDERADO
+    };
+    VarianteGrafo variante = NAO_DIRECIONADO_PONDERADO; // a mesma dos valores padrão acima
+    bool interativo = true; // quando falso, nada é perguntado ao usuário e os nós inexistentes são criados
     string nomeArquivoSaida;
     string nomeDefaultNosSemAresta = "NO_SEM_ARESTA";
+    // AGM mantida a cada edição do grafo. Nula quando desativada. A exclusão de nós e a reordenação a reconstroem
+    // inteira, em O(E log n)
+    FlorestaDinamica *agmDinamica = NULL;
+    GrafoCompacto *compacto = NULL; // representação compacta usada na cobertura. Nula quando precisa ser reconstruída
+    KernelCobertura *kernel = NULL; // grafo reduzido no qual as coberturas são construídas, invalidado junto com compacto
+    long long limiteInferior = -1; // limite inferior do peso da cobertura mínima, ou -1 quando precisa ser recalculado
+    PoolThreads *pool = NULL; // threads usadas pelos algoritmos paralelos, criadas no primeiro uso
+    int numThreads = thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 1;
+    unsigned long long semente; // semente mestre das randomizações
+    MetricasGrafo metricas; // contadores de trabalho dos algoritmos, desligados por padrão
+
+    void construirAGMDinamica();
+    GrafoCompacto *getGrafoCompacto();
+    KernelCobertura *getKernel();
+    PoolThreads *getPool();
+    void invalidarGrafoCompacto();
+    void aplicarOrdem(const vector<int> &ordem);
 
     void lerArquivo(string nomeArquivoEntrada);
-    int getIndexNo(string id);
+    void lerArquivoPesos(string nomeArquivoPesos);
     int adicionarNoInexistente(string id);
     bool isSimples();
     void printMensagemNoInexistente(string id);
-    int componentesFortementeConexas();
+    void printNos(const vector<int> &indices, ostream &saida);
+    void printArestas(const vector<pair<int, int>> &arestas, ostream &saida);
     void ordemBuscaProfundidade(int indice, vector<bool> *visitado, stack<int> &pilha);
-    void buscaEmProfundidadeAux(int indiceOrigem, vector<bool> *visitado, bool print);
-    void noArticulacaoAux(int indice, vector<bool> *visitado, vector<int> *descoberta, vector<int> *min, vector<int> *pai, bool *existe);
-    void arestasPonteAux(int indice, vector<bool> *visitado, vector<int> *descoberta, vector<int> *min, vector<int> *pai, bool *existe);
+    void buscaEmProfundidadeAux(int indiceOrigem, vector<bool> *visitado, vector<int> *ordem,
+                                long long *arestasVisitadas);
+    void noArticulacaoAux(int indice, vector<bool> *visitado, vector<int> *descoberta, vector<int> *min, vector<int> *pai,
+                          int *tempo, vector<bool> *articulacao);
+    void arestasPonteAux(int indice, vector<bool> *visitado, vector<int> *descoberta, vector<int> *min, vector<int> *pai,
+                         int *tempo, vector<pair<int, int>> *pontes);
     vector<vector<int>>* floydAux();
-    int dijkstraAux(int indiceOrigem, int indiceDestino);
-    int kruskalAux();
-    pair<vector<No*>, int> construirSolucao(double alpha);
-    pair<vector<No*>, int> construirSolucaoRandomizada(double alpha, int numIteracoes);
-    void atualizaNosEArestas(No *noAdicionado, vector<pair<int, int>> *arestasGeral, vector<pair<No*, int>> *nosAux);
+    template<bool Ponderado> int dijkstraAux(int indiceOrigem, int indiceDestino);
+    void definirVariante();
+    template<bool Digrafo, bool Ponderado, typename Funcao> void paraCadaArestaAux(Funcao f);
+    template<typename Funcao> void paraCadaAresta(Funcao f);
+    int kruskalAux(vector<pair<int, int>> *arestasAGM);
+    int boruvkaAux(vector<pair<int, int>> *arestasAGM);
+    void construirSolucao(double alpha, unsigned int semente, GrafoCompacto *g, EstadoConstrucao *estado,
+                          SolucaoCobertura *solucao);
+    pair<vector<int>, long long> executarIteracoesGrasp(int inicio, const vector<double> &alphas,
+                                                        vector<long long> *pesos, ControleGrasp *controle);
+    void atualizaNosEArestas(int indiceNoAdicionado, GrafoCompacto *g, EstadoConstrucao *estado,
+                             SolucaoCobertura *solucao, int *arestasNaoAtendidas);
+    void printSolucaoCobertura(const vector<int> &solucao);
+    void printReducaoCobertura();
+    void printLimiteInferior(long long peso);
 public:
     Grafo(string nomeArquivoEntrada, string nomeArquivoSaida);
     ~Grafo();
     bool ehPonderado() { return isPonderado; };
+    bool ehDigrafo() { return isDigrafo; };
+    void setInterativo(bool interativo) { this->interativo = interativo; };
+    int getIndexNo(string_view id) { return idMap.buscar(id); }; // índice do nó, ou -1 quando ele não existe
+    bool existeNo(string_view id) { return getIndexNo(id) != -1; };
+    string getIdNo(int indice) { return string(nos.getId(indice)); };
+    bool mantemAGM() { return agmDinamica != NULL; };
+    void setManterAGM(bool manter);
+    unsigned long long getSemente() { return semente; };
+    void setSemente(unsigned long long semente);
+    int getNumThreads() { return numThreads; };
+    void setNumThreads(int numThreads);
+    MetricasGrafo *getMetricas() { return &metricas; };
+    bool reordenarNos(string criterio);
     vector<int> excentricidade();
     void printGrafo();
     void salvarArquivo();
     void buscaEmProfundidade(string id);
     void buscaEmLargura(string id);
-    void inserirNo(string id);
-    void excluirNo(string id);
-    void inserirAresta(string idOrigem, string idDestino, int peso);
-    void excluirAresta(string idOrigem, string idDestino);
+    bool inserirNo(string id);
+    bool excluirNo(string id);
+    bool inserirAresta(string idOrigem, string idDestino, int peso);
+    bool excluirAresta(string idOrigem, string idDestino);
     void grauNo(string id);
     void vizinhancaAberta(string id);
     void vizinhancaFechada(string id);
@@ -77,9 +161,40 @@ public:
     void centroGrafo();
     void periferiaGrafo();
     void showComponentesFortementeConexas();
-    void showArvoreGeradoraMinima();
+    void showArvoreGeradoraMinima(bool usarBoruvka);
+    int pesoArvoreGeradoraMinima(bool usarBoruvka);
     void showCoberturaGuloso();
-    void showCoberturaGulosoRandomizado(double alpha, int numIteracoes);
-    void showCoberturaGulosoRandomizadoReativo(int numIteracoes, int blocoIteracoes);
+    void showCoberturaGulosoRandomizado(double alpha, int numIteracoes, double tempoLimite);
+    void showCoberturaGulosoRandomizadoReativo(int numIteracoes, int blocoIteracoes, double tempoLimite);
+    void showCoberturaPrimalDual();
+    void showCoberturaExata(double tempoLimite);
+
+    // versões das consultas que retornam os índices dos nós ou os valores em vez de imprimi-los
+    int getGrauEntrada(int indice);
+    int getGrauSaida(int indice);
+    vector<int> getVizinhos(int indice);
+    vector<int> getSequenciaDeGraus();
+    vector<int> getCentro();
+    vector<int> getPeriferia();
+    vector<int> getFechoTransitivoIndireto(int indice);
+    vector<int> ordemBuscaEmLargura(int indiceInicio);
+    vector<int> getFechoTransitivoDireto(int indice);
+    vector<int> ordemBuscaEmProfundidade(int indiceInicio);
+    vector<pair<int, int>> getArestasPonte();
+    vector<int> getNosArticulacao();
+    vector<int> getComponentesFortementeConexas(int *numComponentes, vector<int> *ordem);
+    int arvoreGeradoraMinima(bool usarBoruvka, vector<pair<int, int>> *arestasAGM);
+
+    // versões dos algoritmos de cobertura que retornam a solução (índices dos nós) e o seu peso em vez de imprimi-la.
+    // Os GRASPs sempre executam a primeira iteração, mesmo com o prazo esgotado. O peso LLONG_MAX só é retornado quando
+    // numIteracoes não é positivo e indica que não há solução
+    pair<vector<int>, long long> construirSolucaoGulosa();
+    pair<vector<int>, long long> construirSolucaoRandomizada(double alpha, int numIteracoes, double tempoLimite);
+    pair<vector<int>, long long> construirSolucaoReativa(int numIteracoes, int blocoIteracoes, double tempoLimite,
+                                                         vector<alphaProb> *alphaProbs);
+    pair<vector<int>, long long> construirSolucaoPrimalDual(long long *limiteEmpacotamento);
+    bool construirSolucaoExata(double tempoLimite, pair<vector<int>, long long> *solucao, bool *otima,
+                               long long *nosExplorados);
+    long long getLimiteInferiorCobertura();
 };
 
@@ -0,0 +1,41 @@
+#include "GrafoCompacto.h"
+#include <algorithm>
+
+GrafoCompacto::GrafoCompacto(int numNos, const vector<pair<int, int>> &arestas, const vector<long long> &pesoNo) {
+    this->pesoNo = pesoNo;
+    laco = vector<bool>(numNos, false);
+
+    // primeiro contamos quantas posições cada nó ocupa para, então, preencher as listas de vizinhos
+    inicio = vector<int>(numNos + 1, 0);
+    for (int i = 0; i < arestas.size(); i++) {
+        if (arestas[i].first == arestas[i].second) laco[arestas[i].first] = true;
+        inicio[arestas[i].first + 1]++;
+        if (arestas[i].first != arestas[i].second) inicio[arestas[i].second + 1]++;
+    }
+    for (int v = 0; v < numNos; v++) inicio[v + 1] += inicio[v];
+
+    vizinhos = vector<int>(inicio[numNos]);
+    vector<int> proximo(inicio.begin(), inicio.end() - 1);
+    for (int i = 0; i < arestas.size(); i++) {
+        vizinhos[proximo[arestas[i].first]++] = arestas[i].second;
+        if (arestas[i].first != arestas[i].second) vizinhos[proximo[arestas[i].second]++] = arestas[i].first;
+    }
+
+    // ordenamos os vizinhos de cada nó e removemos os repetidos, compactando as listas para o começo do vector
+    int escrita = 0;
+    for (int v = 0; v < numNos; v++) {
+        int fim = inicio[v + 1];
+        sort(vizinhos.begin() + inicio[v], vizinhos.begin() + fim);
+        int novoInicio = escrita;
+        for (int i = inicio[v]; i < fim; i++) {
+            if (i == inicio[v] || vizinhos[i] != vizinhos[i - 1]) {
+                vizinhos[escrita++] = vizinhos[i];
+                // cada aresta aparece nas listas das suas duas pontas, exceto laços
+                if (vizinhos[i] >= v) numArestas++;
+            }
+        }
+        inicio[v] = novoInicio;
+    }
+    inicio[numNos] = escrita;
+    vizinhos.resize(escrita);
+}
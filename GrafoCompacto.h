@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+// Representação compacta (CSR) do grafo não direcionado subjacente, usada pelos algoritmos de cobertura de vértices.
+// Os vizinhos do nó v ocupam as posições inicio[v] até inicio[v + 1] - 1 do vector vizinhos, o que permite percorrer
+// as adjacências de forma contígua e indexar dados auxiliares pelas posições das arestas. Arestas paralelas e
+// arestas nos dois sentidos de um digrafo são unificadas. Laços aparecem uma única vez na lista do próprio nó
+class GrafoCompacto {
+private:
+    vector<int> inicio;
+    vector<int> vizinhos;
+    vector<long long> pesoNo;
+    vector<bool> laco; // indica se o nó tem laço, caso em que ele precisa estar em qualquer cobertura
+    int numArestas = 0;
+public:
+    GrafoCompacto(int numNos, const vector<pair<int, int>> &arestas, const vector<long long> &pesoNo);
+
+    int getNumNos() { return pesoNo.size(); };
+
+    // número de arestas distintas do grafo, contando laços
+    int getNumArestas() { return numArestas; };
+
+    int getGrau(int v) { return inicio[v + 1] - inicio[v]; };
+
+    long long getPeso(int v) { return pesoNo[v]; };
+
+    bool temLaco(int v) { return laco[v]; };
+
+    const int *vizinhosBegin(int v) { return vizinhos.data() + inicio[v]; };
+
+    const int *vizinhosEnd(int v) { return vizinhos.data() + inicio[v + 1]; };
+};
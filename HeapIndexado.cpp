@@ -0,0 +1,64 @@
+#include "HeapIndexado.h"
+#include <algorithm>
+
+void HeapIndexado::reiniciar(int numNos) {
+    heap.clear();
+    posicao.assign(numNos, -1);
+    chave.resize(numNos);
+}
+
+bool HeapIndexado::antes(int a, int b) {
+    return chave[a] > chave[b] || (chave[a] == chave[b] && a < b);
+}
+
+void HeapIndexado::trocar(int i, int j) {
+    swap(heap[i], heap[j]);
+    posicao[heap[i]] = i;
+    posicao[heap[j]] = j;
+}
+
+void HeapIndexado::subir(int i) {
+    while (i > 0 && antes(heap[i], heap[(i - 1) / 2])) {
+        trocar(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void HeapIndexado::descer(int i) {
+    while (true) {
+        int maior = i;
+        int esq = 2 * i + 1, dir = 2 * i + 2;
+        if (esq < heap.size() && antes(heap[esq], heap[maior])) maior = esq;
+        if (dir < heap.size() && antes(heap[dir], heap[maior])) maior = dir;
+        if (maior == i) return;
+        trocar(i, maior);
+        i = maior;
+    }
+}
+
+void HeapIndexado::inserir(int v, long long novaChave) {
+    chave[v] = novaChave;
+    posicao[v] = heap.size();
+    heap.push_back(v);
+    subir(posicao[v]);
+}
+
+void HeapIndexado::alterar(int v, long long novaChave) {
+    long long antiga = chave[v];
+    chave[v] = novaChave;
+    if (novaChave > antiga) subir(posicao[v]);
+    else descer(posicao[v]);
+}
+
+void HeapIndexado::remover(int v) {
+    int i = posicao[v];
+    trocar(i, heap.size() - 1);
+    heap.pop_back();
+    posicao[v] = -1;
+    if (i < heap.size()) {
+        // o nó que ocupou a posição pode precisar tanto subir quanto descer
+        int movido = heap[i];
+        subir(i);
+        descer(posicao[movido]);
+    }
+}
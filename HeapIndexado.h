@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+// Heap binário de máximo sobre os nós 0..n-1, em que cada nó aparece no máximo uma vez. A posição de cada nó no heap
+// é guardada, o que permite remover um nó ou alterar a sua chave em O(log n). Entre chaves iguais, o nó de menor índice
+// fica no topo, o que mantém as escolhas determinísticas
+class HeapIndexado {
+private:
+    vector<int> heap;
+    vector<int> posicao; // posição do nó no heap, ou -1 quando ele não está no heap
+    vector<long long> chave;
+
+    bool antes(int a, int b);
+    void trocar(int i, int j);
+    void subir(int i);
+    void descer(int i);
+public:
+    // esvazia o heap e prepara-o para os nós 0..numNos-1
+    void reiniciar(int numNos);
+
+    bool vazio() { return heap.empty(); };
+
+    bool contem(int v) { return posicao[v] != -1; };
+
+    // nó de maior chave. O heap não pode estar vazio
+    int topo() { return heap[0]; };
+
+    void inserir(int v, long long novaChave);
+
+    // o nó precisa estar no heap
+    void alterar(int v, long long novaChave);
+
+    // o nó precisa estar no heap
+    void remover(int v);
+};
@@ -0,0 +1,348 @@
+#include "InterpretadorConsultas.h"
+#include "PoolThreads.h"
+#include <sstream>
+#include <cstdlib>
+#include <climits>
+
+static string escaparJson(const string &s) {
+    string escapado = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') escapado += '\\';
+        escapado += ch;
+    }
+    return escapado + "\"";
+}
+
+// converte o argumento em número, retornando false quando ele não é um número válido
+static bool lerInteiro(const string &s, long long *valor) {
+    char *fim;
+    *valor = strtoll(s.c_str(), &fim, 10);
+    return !s.empty() && *fim == '\0';
+}
+
+static bool lerReal(const string &s, double *valor) {
+    char *fim;
+    *valor = strtod(s.c_str(), &fim);
+    return !s.empty() && *fim == '\0';
+}
+
+InterpretadorConsultas::InterpretadorConsultas(Grafo *grafo) {
+    this->grafo = grafo;
+}
+
+Consulta InterpretadorConsultas::analisar(int linha, const string &texto) {
+    Consulta consulta;
+    consulta.linha = linha;
+    consulta.texto = texto;
+    istringstream palavras(texto);
+    string palavra;
+    while (palavras >> palavra) consulta.argumentos.push_back(palavra);
+    return consulta;
+}
+
+bool InterpretadorConsultas::ehConcorrente(const Consulta &consulta) {
+    if (consulta.argumentos.empty()) return true;
+    const string &comando = consulta.argumentos[0];
+    return comando == "dijkstra" || comando == "floyd" || comando == "ordem" || comando == "grau" ||
+           comando == "kruskal" || comando == "componentes" || comando == "grau-no" || comando == "vizinhos" ||
+           comando == "largura" || comando == "profundidade" || comando == "fecho-direto" ||
+           comando == "fecho-indireto" || comando == "sequencia-graus" || comando == "centro" ||
+           comando == "periferia" || comando == "pontes" || comando == "articulacao";
+}
+
+bool InterpretadorConsultas::alteraEstado(const Consulta &consulta) {
+    if (consulta.argumentos.empty()) return false;
+    const string &comando = consulta.argumentos[0];
+    return comando == "inserir-no" || comando == "excluir-no" || comando == "inserir-aresta" ||
+           comando == "excluir-aresta" || comando == "semente" || comando == "threads" || comando == "salvar";
+}
+
+// lista de nós como array JSON com os seus ids
+static string nosJson(Grafo *grafo, const vector<int> &indices) {
+    string json = "[";
+    for (int i = 0; i < indices.size(); i++) {
+        if (i > 0) json += ", ";
+        json += escaparJson(grafo->getIdNo(indices[i]));
+    }
+    return json + "]";
+}
+
+// solução de cobertura como objeto JSON, com os ids dos nós
+static string coberturaJson(Grafo *grafo, const pair<vector<int>, long long> &solucao, const string &extras) {
+    return "{\"peso\": " + to_string(solucao.second) + ", \"nos\": " + nosJson(grafo, solucao.first) + extras + "}";
+}
+
+// Comandos aceitos (argumentos entre colchetes são opcionais):
+//   dijkstra <origem> <destino>, floyd <origem> <destino>   distância, ou null quando não há caminho
+//   ordem, grau, kruskal, boruvka, componentes               valor inteiro
+//   grau-no <id>                                             graus de entrada e de saída
+//   vizinhos <id>, largura <id>, profundidade <id>           ids dos nós
+//   fecho-direto <id>, fecho-indireto <id>, centro, periferia, articulacao
+//                                                            ids dos nós
+//   pontes                                                   arestas como pares de ids
+//   sequencia-graus                                          grau de cada nó
+//   guloso, randomizado <alfa> <iteracoes> [tempo], reativo <iteracoes> <bloco> [tempo], primal-dual, exato [tempo]
+//                                                            cobertura com o seu peso e os ids dos nós
+//   limite-inferior                                          limite inferior do peso da cobertura
+//   inserir-no <id>, excluir-no <id>, inserir-aresta <origem> <destino> [peso], excluir-aresta <origem> <destino>
+//   semente <semente>, threads <n>, salvar
+string InterpretadorConsultas::executarComando(const Consulta &consulta, string *erro) {
+    const vector<string> &args = consulta.argumentos;
+    if (args.empty()) {
+        *erro = "consulta vazia";
+        return "";
+    }
+    const string &comando = args[0];
+    int numArgs = args.size() - 1;
+
+    if (comando == "dijkstra" || comando == "floyd") {
+        if (numArgs != 2) {
+            *erro = "uso: " + comando + " <origem> <destino>";
+            return "";
+        }
+        for (int i = 1; i <= 2; i++) {
+            if (!grafo->existeNo(args[i])) {
+                *erro = "no " + args[i] + " inexistente";
+                return "";
+            }
+        }
+        int distancia = comando == "dijkstra" ? grafo->dijkstra(args[1], args[2]) : grafo->floyd(args[1], args[2]);
+        return distancia == INT_MAX ? "null" : to_string(distancia);
+    }
+
+    if (comando == "grau-no" || comando == "vizinhos" || comando == "largura" || comando == "profundidade" ||
+        comando == "fecho-direto" || comando == "fecho-indireto") {
+        if (numArgs != 1) {
+            *erro = "uso: " + comando + " <id>";
+            return "";
+        }
+        int indice = grafo->getIndexNo(args[1]);
+        if (indice == -1) {
+            *erro = "no " + args[1] + " inexistente";
+            return "";
+        }
+        if (comando == "grau-no")
+            return "{\"entrada\": " + to_string(grafo->getGrauEntrada(indice)) + ", \"saida\": " +
+                   to_string(grafo->getGrauSaida(indice)) + "}";
+        if (comando == "vizinhos") return nosJson(grafo, grafo->getVizinhos(indice));
+        if (comando == "profundidade") return nosJson(grafo, grafo->ordemBuscaEmProfundidade(indice));
+        if (comando == "fecho-direto") return nosJson(grafo, grafo->getFechoTransitivoDireto(indice));
+        if (comando == "fecho-indireto") return nosJson(grafo, grafo->getFechoTransitivoIndireto(indice));
+        return nosJson(grafo, grafo->ordemBuscaEmLargura(indice));
+    }
+
+    if (comando == "sequencia-graus" || comando == "centro" || comando == "periferia" || comando == "pontes" ||
+        comando == "articulacao") {
+        if (numArgs != 0) {
+            *erro = "o comando " + comando + " nao tem argumentos";
+            return "";
+        }
+        if (comando == "centro") return nosJson(grafo, grafo->getCentro());
+        if (comando == "periferia") return nosJson(grafo, grafo->getPeriferia());
+        if (comando == "articulacao") return nosJson(grafo, grafo->getNosArticulacao());
+        if (comando == "pontes") {
+            vector<pair<int, int>> pontes = grafo->getArestasPonte();
+            string json = "[";
+            for (int i = 0; i < pontes.size(); i++)
+                json += (i > 0 ? ", [" : "[") + escaparJson(grafo->getIdNo(pontes[i].first)) + ", " +
+                        escaparJson(grafo->getIdNo(pontes[i].second)) + "]";
+            return json + "]";
+        }
+        vector<int> graus = grafo->getSequenciaDeGraus();
+        string json = "[";
+        for (int i = 0; i < graus.size(); i++) json += (i > 0 ? ", " : "") + to_string(graus[i]);
+        return json + "]";
+    }
+
+    if (comando == "ordem" || comando == "grau" || comando == "kruskal" || comando == "boruvka" ||
+        comando == "componentes" || comando == "guloso" || comando == "primal-dual" ||
+        comando == "limite-inferior" || comando == "salvar") {
+        if (numArgs != 0) {
+            *erro = "o comando " + comando + " nao tem argumentos";
+            return "";
+        }
+        if (comando == "ordem") return to_string(grafo->ordemGrafo());
+        if (comando == "grau") return to_string(grafo->grauGrafo());
+        if (comando == "kruskal" || comando == "boruvka")
+            return to_string(grafo->pesoArvoreGeradoraMinima(comando == "boruvka"));
+        if (comando == "componentes") {
+            if (!grafo->ehDigrafo()) {
+                *erro = "componentes fortemente conexas so se aplicam em grafos direcionados";
+                return "";
+            }
+            int numComponentes;
+            grafo->getComponentesFortementeConexas(&numComponentes, NULL);
+            return to_string(numComponentes);
+        }
+        if (comando == "guloso") return coberturaJson(grafo, grafo->construirSolucaoGulosa(), "");
+        if (comando == "primal-dual") {
+            long long limiteEmpacotamento;
+            pair<vector<int>, long long> solucao = grafo->construirSolucaoPrimalDual(&limiteEmpacotamento);
+            return coberturaJson(grafo, solucao, ", \"limite_empacotamento\": " + to_string(limiteEmpacotamento));
+        }
+        if (comando == "limite-inferior") return to_string(grafo->getLimiteInferiorCobertura());
+        grafo->salvarArquivo();
+        return "null";
+    }
+
+    if (comando == "randomizado") {
+        double alfa, tempoLimite = 0;
+        long long iteracoes;
+        if ((numArgs != 2 && numArgs != 3) || !lerReal(args[1], &alfa) || !lerInteiro(args[2], &iteracoes) ||
+            (numArgs == 3 && !lerReal(args[3], &tempoLimite)) || alfa < 0 || alfa > 1 || iteracoes <= 0 ||
+            tempoLimite < 0) {
+            *erro = "uso: randomizado <alfa entre 0 e 1> <iteracoes> [tempo]";
+            return "";
+        }
+        pair<vector<int>, long long> solucao = grafo->construirSolucaoRandomizada(alfa, iteracoes, tempoLimite);
+        if (solucao.second == LLONG_MAX) {
+            *erro = "nenhuma iteracao executada";
+            return "";
+        }
+        return coberturaJson(grafo, solucao, "");
+    }
+
+    if (comando == "reativo") {
+        double tempoLimite = 0;
+        long long iteracoes, bloco;
+        if ((numArgs != 2 && numArgs != 3) || !lerInteiro(args[1], &iteracoes) || !lerInteiro(args[2], &bloco) ||
+            (numArgs == 3 && !lerReal(args[3], &tempoLimite)) || iteracoes <= 0 || bloco <= 0 || tempoLimite < 0) {
+            *erro = "uso: reativo <iteracoes> <bloco> [tempo]";
+            return "";
+        }
+        vector<alphaProb> alphaProbs;
+        pair<vector<int>, long long> solucao = grafo->construirSolucaoReativa(iteracoes, bloco, tempoLimite, &alphaProbs);
+        if (solucao.second == LLONG_MAX) {
+            *erro = "nenhuma iteracao executada";
+            return "";
+        }
+        return coberturaJson(grafo, solucao, "");
+    }
+
+    if (comando == "exato") {
+        double tempoLimite = 0;
+        if (numArgs > 1 || (numArgs == 1 && (!lerReal(args[1], &tempoLimite) || tempoLimite < 0))) {
+            *erro = "uso: exato [tempo]";
+            return "";
+        }
+        pair<vector<int>, long long> solucao;
+        bool otima;
+        long long nosExplorados;
+        if (!grafo->construirSolucaoExata(tempoLimite, &solucao, &otima, &nosExplorados)) {
+            *erro = "grafo reduzido grande demais para a cobertura exata";
+            return "";
+        }
+        return coberturaJson(grafo, solucao, string(", \"otima\": ") + (otima ? "true" : "false") +
+                                             ", \"nos_explorados\": " + to_string(nosExplorados));
+    }
+
+    if (comando == "inserir-no" || comando == "excluir-no") {
+        if (numArgs != 1) {
+            *erro = "uso: " + comando + " <id>";
+            return "";
+        }
+        if (comando == "inserir-no" && !grafo->inserirNo(args[1])) *erro = "no " + args[1] + " ja existe";
+        if (comando == "excluir-no" && !grafo->excluirNo(args[1])) *erro = "no " + args[1] + " inexistente";
+        return erro->empty() ? "null" : "";
+    }
+
+    if (comando == "inserir-aresta") {
+        long long peso = 1;
+        // pesos negativos quebrariam o Dijkstra e a AGM, e os maiores que INT_MAX não cabem na aresta
+        if ((numArgs != 2 && numArgs != 3) ||
+            (numArgs == 3 && (!lerInteiro(args[3], &peso) || peso < 0 || peso > INT_MAX))) {
+            *erro = "uso: inserir-aresta <origem> <destino> [peso entre 0 e " + to_string(INT_MAX) + "]";
+            return "";
+        }
+        if (!grafo->inserirAresta(args[1], args[2], (int) peso)) {
+            *erro = "aresta ja existe";
+            return "";
+        }
+        return "null";
+    }
+
+    if (comando == "excluir-aresta") {
+        if (numArgs != 2) {
+            *erro = "uso: excluir-aresta <origem> <destino>";
+            return "";
+        }
+        for (int i = 1; i <= 2; i++) {
+            if (!grafo->existeNo(args[i])) {
+                *erro = "no " + args[i] + " inexistente";
+                return "";
+            }
+        }
+        if (!grafo->excluirAresta(args[1], args[2])) {
+            *erro = "aresta inexistente";
+            return "";
+        }
+        return "null";
+    }
+
+    if (comando == "semente" || comando == "threads") {
+        long long valor;
+        if (numArgs != 1 || !lerInteiro(args[1], &valor) || valor < 0 || (comando == "threads" && valor == 0)) {
+            *erro = "uso: " + comando + (comando == "semente" ? " <semente>" : " <n>");
+            return "";
+        }
+        if (comando == "semente") grafo->setSemente(valor);
+        else grafo->setNumThreads(valor);
+        return "null";
+    }
+
+    *erro = "comando desconhecido: " + comando;
+    return "";
+}
+
+string InterpretadorConsultas::executar(const Consulta &consulta) {
+    string erro;
+    string resultado = executarComando(consulta, &erro);
+    return formatarResposta(consulta, resultado, erro);
+}
+
+string InterpretadorConsultas::formatarResposta(const Consulta &consulta, const string &resultado,
+                                                const string &erro) {
+    string resposta = "{\"linha\": " + to_string(consulta.linha) + ", \"consulta\": " + escaparJson(consulta.texto);
+    if (erro.empty()) resposta += ", \"ok\": true, \"resultado\": " + resultado + "}";
+    else resposta += ", \"ok\": false, \"erro\": " + escaparJson(erro) + "}";
+    return resposta;
+}
+
+void InterpretadorConsultas::executarLote(istream &entrada, ostream &saida) {
+    PERFIL_ZONA("lote");
+    vector<Consulta> consultas;
+    string texto;
+    for (int linha = 1; getline(entrada, texto); linha++) {
+        Consulta consulta = analisar(linha, texto);
+        if (consulta.argumentos.empty() || consulta.argumentos[0][0] == '#') continue;
+        consultas.push_back(consulta);
+    }
+
+    PoolThreads *pool = NULL;
+    vector<string> respostas;
+    int inicio = 0;
+    while (inicio < consultas.size()) {
+        if (!ehConcorrente(consultas[inicio])) {
+            saida << executar(consultas[inicio]) << "\n";
+            inicio++;
+            continue;
+        }
+
+        // as consultas concorrentes consecutivas executam juntas e as respostas são escritas na ordem das consultas
+        int fim = inicio;
+        while (fim < consultas.size() && ehConcorrente(consultas[fim])) fim++;
+        // o pool acompanha o número de threads do grafo, que pode ser alterado pela consulta threads
+        if (pool == NULL || pool->getNumThreads() != grafo->getNumThreads()) {
+            delete (pool);
+            pool = new PoolThreads(grafo->getNumThreads());
+        }
+        respostas.assign(fim - inicio, "");
+        pool->paraCada(fim - inicio, [&](int i, int) {
+            respostas[i] = executar(consultas[inicio + i]);
+        });
+        for (int i = 0; i < respostas.size(); i++) saida << respostas[i] << "\n";
+        inicio = fim;
+    }
+    delete (pool);
+    saida.flush();
+}
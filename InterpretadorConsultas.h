@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Grafo.h"
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+
+using namespace std;
+
+// consulta de uma linha de texto, separada em palavras. A primeira palavra é o comando
+struct Consulta {
+    int linha; // posição da consulta na entrada, devolvida na resposta para identificá-la
+    string texto;
+    vector<string> argumentos;
+};
+
+// Interpretador das consultas em texto feitas ao grafo sem passar pelos menus. Cada consulta gera uma resposta em uma
+// linha JSON com o resultado ou o erro. As mensagens que os métodos do grafo imprimem não fazem parte da resposta e
+// devem ser descartadas por quem usa o interpretador
+class InterpretadorConsultas {
+private:
+    Grafo *grafo;
+public:
+    InterpretadorConsultas(Grafo *grafo);
+
+    static Consulta analisar(int linha, const string &texto);
+
+    // true -> a consulta só lê o grafo e pode executar ao mesmo tempo que outras consultas concorrentes. As edições, as
+    // configurações e as coberturas, que preparam o grafo compacto e usam o pool do grafo, executam sozinhas
+    static bool ehConcorrente(const Consulta &consulta);
+
+    // true -> a consulta altera o grafo, as configurações ou o arquivo de saída, e duas consultas iguais não têm,
+    // necessariamente, a mesma resposta
+    static bool alteraEstado(const Consulta &consulta);
+
+    // executa o comando e retorna o resultado como valor JSON, ou uma string vazia após preencher erro
+    string executarComando(const Consulta &consulta, string *erro);
+
+    // resposta em uma linha JSON, sem a quebra de linha, com o resultado ou, quando erro não é vazio, o erro
+    static string formatarResposta(const Consulta &consulta, const string &resultado, const string &erro);
+
+    // executa a consulta e retorna a sua resposta, sem a quebra de linha
+    string executar(const Consulta &consulta);
+
+    // executa as consultas da entrada, uma por linha, ignorando as linhas vazias e as iniciadas por #, e escreve as
+    // respostas na saída na ordem das consultas. As sequências de consultas concorrentes são divididas entre as threads
+    // do grafo (getNumThreads), e cada consulta não concorrente espera as anteriores terminarem
+    void executarLote(istream &entrada, ostream &saida);
+};
@@ -0,0 +1,220 @@
+#include "KernelCobertura.h"
+#include <algorithm>
+#include <tuple>
+
+KernelCobertura::KernelCobertura(GrafoCompacto *g) {
+    this->g = g;
+    int n = g->getNumNos();
+
+    removido.assign(n, false);
+    grau.resize(n);
+    peso.resize(n);
+    pesoVizinhanca.assign(n, 0);
+    naFila.assign(n, false);
+
+    for (int v = 0; v < n; v++) {
+        peso[v] = g->getPeso(v);
+        // o laço não conta no grau, pois os nós com laço são os primeiros a serem reduzidos
+        grau[v] = g->getGrau(v) - (g->temLaco(v) ? 1 : 0);
+    }
+    for (int v = 0; v < n; v++) {
+        for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u)
+            if (*u != v) pesoVizinhanca[v] += peso[*u];
+    }
+
+    // as regras são aplicadas até que nenhuma delas altere o grafo. Cada remoção coloca na fila os vizinhos do nó
+    // removido, que são os únicos nós cujas regras podem passar a se aplicar
+    for (int v = 0; v < n; v++) enfileirar(v);
+    do {
+        while (!fila.empty()) {
+            int v = fila.back();
+            fila.pop_back();
+            naFila[v] = false;
+            reduzirNo(v);
+        }
+    } while (unirGemeos());
+
+    // o grafo reduzido contém os nós restantes com os seus pesos atualizados pelas reduções
+    vector<int> novoIndice(n, -1);
+    vector<long long> pesosReduzidos;
+    for (int v = 0; v < n; v++) {
+        if (removido[v]) continue;
+        novoIndice[v] = original.size();
+        original.push_back(v);
+        pesosReduzidos.push_back(peso[v]);
+    }
+    vector<pair<int, int>> arestas;
+    for (int v = 0; v < n; v++) {
+        if (removido[v]) continue;
+        for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u)
+            if (*u > v && !removido[*u]) arestas.push_back(make_pair(novoIndice[v], novoIndice[*u]));
+    }
+    reduzido = new GrafoCompacto(original.size(), arestas, pesosReduzidos);
+
+    // desaloca o estado usado somente nas reduções
+    vector<bool>().swap(removido);
+    vector<int>().swap(grau);
+    vector<long long>().swap(peso);
+    vector<long long>().swap(pesoVizinhanca);
+    vector<int>().swap(fila);
+    vector<bool>().swap(naFila);
+}
+
+KernelCobertura::~KernelCobertura() {
+    delete (reduzido);
+}
+
+void KernelCobertura::enfileirar(int v) {
+    if (!naFila[v] && !removido[v]) {
+        naFila[v] = true;
+        fila.push_back(v);
+    }
+}
+
+void KernelCobertura::remover(int v) {
+    removido[v] = true;
+    for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u) {
+        if (*u == v || removido[*u]) continue;
+        grau[*u]--;
+        pesoVizinhanca[*u] -= peso[v];
+        enfileirar(*u);
+    }
+}
+
+void KernelCobertura::incluir(int v) {
+    Registro r = {INCLUIDO, v, -1};
+    registros.push_back(r);
+    deslocamento += peso[v];
+    remover(v);
+}
+
+void KernelCobertura::excluir(int v) {
+    Registro r = {EXCLUIDO, v, -1};
+    registros.push_back(r);
+    remover(v);
+}
+
+void KernelCobertura::alterarPeso(int v, long long delta) {
+    peso[v] += delta;
+    for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u) {
+        if (*u == v || removido[*u]) continue;
+        pesoVizinhanca[*u] += delta;
+        enfileirar(*u);
+    }
+    enfileirar(v);
+}
+
+int KernelCobertura::vizinhoRestante(int v) {
+    for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u)
+        if (*u != v && !removido[*u]) return *u;
+    return -1;
+}
+
+// aplica ao nó v a primeira regra que se aplicar a ele e retorna se alguma regra foi aplicada
+bool KernelCobertura::reduzirNo(int v) {
+    if (removido[v]) return false;
+
+    if (g->temLaco(v)) {
+        incluir(v);
+    } else if (grau[v] == 0) {
+        excluir(v);
+    } else if (peso[v] == 0) {
+        incluir(v);
+    } else if (pesoVizinhanca[v] <= peso[v]) {
+        for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u)
+            if (*u != v && !removido[*u]) incluir(*u);
+        excluir(v);
+    } else if (grau[v] == 1) {
+        // como a regra da vizinhança não se aplicou, o vizinho é mais pesado do que v
+        int u = vizinhoRestante(v);
+        Registro r = {DOBRADO, v, u};
+        registros.push_back(r);
+        deslocamento += peso[v];
+        remover(v);
+        alterarPeso(u, -peso[v]);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// une os gêmeos encontrados e retorna se algum par foi unido. Os candidatos são agrupados pelo grau e por um hash da
+// vizinhança, e a igualdade das vizinhanças é confirmada antes da união
+bool KernelCobertura::unirGemeos() {
+    int n = g->getNumNos();
+    vector<tuple<int, unsigned long long, int>> assinaturas;
+    for (int v = 0; v < n; v++) {
+        if (removido[v]) continue;
+        unsigned long long hash = 0;
+        for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u) {
+            if (removido[*u]) continue;
+            unsigned long long x = (unsigned long long) *u * 0x9E3779B97F4A7C15ULL;
+            hash += x ^ (x >> 29);
+        }
+        assinaturas.push_back(make_tuple(grau[v], hash, v));
+    }
+    sort(assinaturas.begin(), assinaturas.end());
+
+    bool uniu = false;
+    vector<int> vizinhosU, vizinhosV;
+    for (int i = 0; i < assinaturas.size();) {
+        int j = i + 1;
+        while (j < assinaturas.size() && get<0>(assinaturas[j]) == get<0>(assinaturas[i]) &&
+               get<1>(assinaturas[j]) == get<1>(assinaturas[i]))
+            j++;
+
+        // o primeiro nó do grupo que ainda não foi removido recebe os seus gêmeos
+        int u = get<2>(assinaturas[i]);
+        vizinhosU.clear();
+        for (const int *x = g->vizinhosBegin(u); x != g->vizinhosEnd(u); ++x)
+            if (!removido[*x]) vizinhosU.push_back(*x);
+
+        for (int k = i + 1; k < j; k++) {
+            int v = get<2>(assinaturas[k]);
+            if (removido[u] || removido[v] || grau[v] != grau[u]) continue;
+            vizinhosV.clear();
+            for (const int *x = g->vizinhosBegin(v); x != g->vizinhosEnd(v); ++x)
+                if (!removido[*x]) vizinhosV.push_back(*x);
+            if (vizinhosU != vizinhosV) continue;
+
+            // v é removido e o seu peso passa para u. A vizinhança dos vizinhos mantém o mesmo peso total
+            Registro r = {UNIDO, v, u};
+            registros.push_back(r);
+            long long pesoV = peso[v];
+            remover(v);
+            alterarPeso(u, pesoV);
+            uniu = true;
+        }
+        i = j;
+    }
+    return uniu;
+}
+
+vector<int> KernelCobertura::elevar(const vector<int> &solucaoReduzida) {
+    vector<bool> naCobertura(g->getNumNos(), false);
+    for (int i = 0; i < solucaoReduzida.size(); i++) naCobertura[original[solucaoReduzida[i]]] = true;
+
+    // os registros são desfeitos na ordem inversa, de forma que a decisão do nó u de um registro já esteja definida
+    for (int i = (int) registros.size() - 1; i >= 0; i--) {
+        const Registro &r = registros[i];
+        switch (r.tipo) {
+            case INCLUIDO:
+                naCobertura[r.v] = true;
+                break;
+            case EXCLUIDO:
+                naCobertura[r.v] = false;
+                break;
+            case DOBRADO:
+                naCobertura[r.v] = !naCobertura[r.u];
+                break;
+            case UNIDO:
+                naCobertura[r.v] = naCobertura[r.u];
+                break;
+        }
+    }
+
+    vector<int> solucao;
+    for (int v = 0; v < naCobertura.size(); v++)
+        if (naCobertura[v]) solucao.push_back(v);
+    return solucao;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "GrafoCompacto.h"
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Pré-processamento da cobertura mínima de vértices ponderados. Aplica regras de redução que preservam a existência
+// de uma solução ótima até que nenhuma regra se aplique, produzindo um grafo reduzido (kernel) e os registros
+// necessários para transformar uma cobertura do kernel em uma cobertura do grafo original:
+// - nós com laço entram na cobertura e nós de peso 0 também, pois não custam nada;
+// - nós de grau 0 são removidos, pois não precisam estar na cobertura;
+// - quando o peso da vizinhança de v não supera o peso de v, a vizinhança entra na cobertura e v é removido;
+// - um nó v de grau 1 mais leve do que o seu vizinho u é dobrado em u: o peso de v é descontado de u e, na solução,
+//   v entra na cobertura se e somente se u não entrar;
+// - nós não adjacentes com a mesma vizinhança (gêmeos) são unidos em um só nó com a soma dos pesos, pois uma solução
+//   ótima contém ambos ou nenhum deles
+class KernelCobertura {
+private:
+    enum TipoRegistro {
+        INCLUIDO, EXCLUIDO, DOBRADO, UNIDO
+    };
+
+    struct Registro {
+        TipoRegistro tipo;
+        int v; // nó removido
+        int u; // nó do qual a decisão de v depende nos registros DOBRADO e UNIDO
+    };
+
+    GrafoCompacto *g; // grafo original, que não pertence ao kernel
+    GrafoCompacto *reduzido = NULL;
+    vector<int> original; // índice no grafo original de cada nó do grafo reduzido
+    vector<Registro> registros;
+    long long deslocamento = 0; // peso já garantido na cobertura pelas reduções
+
+    // estado das reduções, descartado ao fim da construção
+    vector<bool> removido;
+    vector<int> grau;
+    vector<long long> peso;
+    vector<long long> pesoVizinhanca;
+    vector<int> fila;
+    vector<bool> naFila;
+
+    void enfileirar(int v);
+    void remover(int v);
+    void incluir(int v);
+    void excluir(int v);
+    void alterarPeso(int v, long long delta);
+    int vizinhoRestante(int v);
+    bool reduzirNo(int v);
+    bool unirGemeos();
+public:
+    KernelCobertura(GrafoCompacto *g);
+
+    ~KernelCobertura();
+
+    GrafoCompacto *getReduzido() { return reduzido; };
+
+    // peso que deve ser somado ao peso de uma cobertura do grafo reduzido para obter o peso da cobertura original
+    long long getDeslocamento() { return deslocamento; };
+
+    // transforma uma cobertura do grafo reduzido (índices do grafo reduzido) em uma cobertura do grafo original
+    vector<int> elevar(const vector<int> &solucaoReduzida);
+};
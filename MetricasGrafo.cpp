@@ -0,0 +1,36 @@
+#include "MetricasGrafo.h"
+
+// nomes dos contadores no JSON, na ordem do enum Metrica
+static const char *nomesMetricas[NUM_METRICAS] = {
+        "dijkstra_nos_fixados",
+        "dijkstra_arestas_relaxadas",
+        "dijkstra_operacoes_heap",
+        "busca_arestas_visitadas",
+        "cobertura_construcoes",
+        "cobertura_escolhas_gulosas",
+        "cobertura_atualizacoes_grau",
+        "cobertura_trocas_heap",
+        "cobertura_religamentos",
+        "cobertura_nos_exata"
+};
+
+MetricasGrafo::MetricasGrafo() : ativas(false) {
+    zerar();
+}
+
+void MetricasGrafo::setAtivas(bool ativas) {
+    this->ativas.store(ativas, memory_order_relaxed);
+}
+
+void MetricasGrafo::zerar() {
+    for (int i = 0; i < NUM_METRICAS; i++) contadores[i].store(0, memory_order_relaxed);
+}
+
+void MetricasGrafo::escreverJson(ostream &out) const {
+    out << "{\n  \"ativas\": " << (getAtivas() ? "true" : "false") << ",\n  \"contadores\": {\n";
+    for (int i = 0; i < NUM_METRICAS; i++) {
+        out << "    \"" << nomesMetricas[i] << "\": " << getContador((Metrica) i);
+        out << (i + 1 < NUM_METRICAS ? ",\n" : "\n");
+    }
+    out << "  }\n}\n";
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <ostream>
+
+using namespace std;
+
+// contadores de trabalho dos algoritmos, na ordem em que aparecem no retrato
+enum Metrica {
+    DIJKSTRA_NOS_FIXADOS,
+    DIJKSTRA_ARESTAS_RELAXADAS,
+    DIJKSTRA_OPERACOES_HEAP,
+    BUSCA_ARESTAS_VISITADAS,
+    COBERTURA_CONSTRUCOES,
+    COBERTURA_ESCOLHAS_GULOSAS,
+    COBERTURA_ATUALIZACOES_GRAU,
+    COBERTURA_TROCAS_HEAP,
+    COBERTURA_RELIGAMENTOS,
+    COBERTURA_NOS_EXATA,
+    NUM_METRICAS
+};
+
+// Registro de métricas de um grafo. A contagem é ligada e desligada em tempo de execução e, quando desligada, cada
+// registro custa somente a leitura de um booleano. Os algoritmos acumulam as contagens em variáveis locais e as somam
+// ao registro uma vez por execução (ou por tarefa, nas threads do pool), com operações atômicas relaxadas, já que os
+// contadores são independentes entre si e só precisam estar corretos quando o retrato é lido
+class MetricasGrafo {
+private:
+    atomic<bool> ativas;
+    atomic<long long> contadores[NUM_METRICAS];
+public:
+    MetricasGrafo();
+
+    bool getAtivas() const { return ativas.load(memory_order_relaxed); };
+
+    void setAtivas(bool ativas);
+
+    void adicionar(Metrica metrica, long long quantidade) {
+        if (getAtivas()) contadores[metrica].fetch_add(quantidade, memory_order_relaxed);
+    };
+
+    long long getContador(Metrica metrica) const { return contadores[metrica].load(memory_order_relaxed); };
+
+    void zerar();
+
+    // escreve o retrato dos contadores como um objeto JSON
+    void escreverJson(ostream &out) const;
+};
@@ -0,0 +1,194 @@
+#include "Perfilador.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <string>
+#include <mutex>
+#include <algorithm>
+#include <climits>
+
+// estatísticas de um nó da árvore em uma thread, em nanossegundos
+struct EstatisticaZona {
+    long long chamadas = 0;
+    long long total = 0;
+    long long minimo = LLONG_MAX;
+    long long maximo = 0;
+
+    void acumular(const EstatisticaZona &outra) {
+        chamadas += outra.chamadas;
+        total += outra.total;
+        minimo = min(minimo, outra.minimo);
+        maximo = max(maximo, outra.maximo);
+    }
+};
+
+struct NoArvorePerfil {
+    string nome;
+    int pai;
+};
+
+// Árvore de zonas compartilhada. Os nós só são criados, nunca removidos, portanto cada thread guarda os filhos que já
+// encontrou e só consulta a árvore, sob a trava, na primeira vez que entra em cada zona a partir de cada pai
+struct ArvorePerfil {
+    mutex trava;
+    vector<NoArvorePerfil> nos;
+    map<pair<int, string>, int> filhos;
+    vector<DadosThread *> threads;
+
+    ArvorePerfil() {
+        NoArvorePerfil raiz = {"", -1};
+        nos.push_back(raiz);
+    }
+
+    ~ArvorePerfil();
+
+    int filho(int pai, const char *nome) {
+        lock_guard<mutex> lock(trava);
+        pair<int, string> chave(pai, nome);
+        map<pair<int, string>, int>::iterator it = filhos.find(chave);
+        if (it != filhos.end()) return it->second;
+        NoArvorePerfil no = {nome, pai};
+        nos.push_back(no);
+        filhos[chave] = nos.size() - 1;
+        return nos.size() - 1;
+    }
+
+    void printRelatorio();
+};
+
+static ArvorePerfil arvore;
+
+// dados de cada thread, que vivem até o fim do programa para entrarem no relatório mesmo depois que a thread termina
+struct DadosThread {
+    int atual = 0;
+    vector<EstatisticaZona> estatisticas;
+    map<pair<int, const char *>, int> filhosConhecidos;
+
+    int filho(int pai, const char *nome) {
+        pair<int, const char *> chave(pai, nome);
+        map<pair<int, const char *>, int>::iterator it = filhosConhecidos.find(chave);
+        if (it != filhosConhecidos.end()) return it->second;
+        int no = arvore.filho(pai, nome);
+        filhosConhecidos[chave] = no;
+        return no;
+    }
+};
+
+static thread_local DadosThread *dadosThread = NULL;
+
+static DadosThread *getDadosThread() {
+    if (dadosThread == NULL) {
+        dadosThread = new DadosThread();
+        lock_guard<mutex> lock(arvore.trava);
+        arvore.threads.push_back(dadosThread);
+    }
+    return dadosThread;
+}
+
+ZonaPerfil::ZonaPerfil(const char *nome) {
+    dados = getDadosThread();
+    anterior = dados->atual;
+    no = dados->filho(anterior, nome);
+    dados->atual = no;
+    inicio = chrono::steady_clock::now();
+}
+
+ZonaPerfil::~ZonaPerfil() {
+    long long duracao = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+    if (no >= dados->estatisticas.size()) dados->estatisticas.resize(no + 1);
+    EstatisticaZona &e = dados->estatisticas[no];
+    e.chamadas++;
+    e.total += duracao;
+    e.minimo = min(e.minimo, duracao);
+    e.maximo = max(e.maximo, duracao);
+    dados->atual = anterior;
+}
+
+int ZonaPerfil::getZonaAtual() {
+    return getDadosThread()->atual;
+}
+
+HerancaZonaPerfil::HerancaZonaPerfil(int no) {
+    dados = getDadosThread();
+    anterior = dados->atual;
+    dados->atual = no;
+}
+
+HerancaZonaPerfil::~HerancaZonaPerfil() {
+    dados->atual = anterior;
+}
+
+static void printLinha(const string &nome, const EstatisticaZona &e, long long proprio) {
+    cerr << left << setw(48) << nome << right << setw(12) << e.chamadas << fixed << setprecision(3)
+         << setw(12) << e.total / 1e6 << setw(12) << proprio / 1e6 << setw(12) << e.total / 1e6 / e.chamadas
+         << setw(12) << e.minimo / 1e6 << setw(12) << e.maximo / 1e6 << "\n";
+}
+
+static void printCabecalho(const string &titulo) {
+    cerr << "\n" << left << setw(48) << titulo << right << setw(12) << "chamadas" << setw(12) << "total(ms)"
+         << setw(12) << "proprio(ms)" << setw(12) << "media(ms)" << setw(12) << "min(ms)" << setw(12) << "max(ms)"
+         << "\n";
+}
+
+// Os tempos das zonas executadas em várias threads são somados, portanto o total de uma zona pode superar o tempo de
+// parede da zona que a contém. O tempo próprio desconta do total o tempo das zonas filhas executadas na mesma thread
+void ArvorePerfil::printRelatorio() {
+    lock_guard<mutex> lock(trava);
+    int n = nos.size();
+    if (n == 1) return;
+
+    vector<EstatisticaZona> soma(n);
+    for (int t = 0; t < threads.size(); t++)
+        for (int i = 0; i < threads[t]->estatisticas.size(); i++) soma[i].acumular(threads[t]->estatisticas[i]);
+
+    // o tempo de uma zona só é descontado do pai na thread em que o pai foi aberto. As zonas das tarefas do pool ficam
+    // dentro de uma zona herdada, aberta por outra thread, e não diminuem o tempo próprio dela
+    vector<long long> proprio(n);
+    for (int t = 0; t < threads.size(); t++) {
+        const vector<EstatisticaZona> &estatisticas = threads[t]->estatisticas;
+        for (int i = 1; i < estatisticas.size(); i++) {
+            proprio[i] += estatisticas[i].total;
+            int pai = nos[i].pai;
+            if (pai < estatisticas.size() && estatisticas[pai].chamadas > 0) proprio[pai] -= estatisticas[i].total;
+        }
+    }
+    vector<vector<int>> filhosNo(n);
+    for (int i = 1; i < n; i++)
+        if (soma[i].chamadas > 0) filhosNo[nos[i].pai].push_back(i);
+
+    // relatório plano: zonas de mesmo nome somadas, em ordem decrescente de tempo próprio
+    map<string, pair<EstatisticaZona, long long>> porNome;
+    for (int i = 1; i < n; i++) {
+        if (soma[i].chamadas == 0) continue;
+        porNome[nos[i].nome].first.acumular(soma[i]);
+        porNome[nos[i].nome].second += proprio[i];
+    }
+    vector<pair<long long, string>> ordemPlana;
+    for (auto &zona : porNome) ordemPlana.push_back(make_pair(-zona.second.second, zona.first));
+    sort(ordemPlana.begin(), ordemPlana.end());
+
+    printCabecalho("Perfil (plano)");
+    for (int i = 0; i < ordemPlana.size(); i++) {
+        pair<EstatisticaZona, long long> &zona = porNome[ordemPlana[i].second];
+        printLinha(ordemPlana[i].second, zona.first, zona.second);
+    }
+
+    // relatório em árvore: filhos em ordem decrescente de tempo total, indentados pela profundidade
+    printCabecalho("Perfil (arvore)");
+    vector<pair<int, int>> pilha; // nó e profundidade
+    for (int i = 0; i < n; i++) {
+        sort(filhosNo[i].begin(), filhosNo[i].end(), [&soma](int a, int b) { return soma[a].total < soma[b].total; });
+    }
+    for (int i = 0; i < filhosNo[0].size(); i++) pilha.push_back(make_pair(filhosNo[0][i], 0));
+    while (!pilha.empty()) {
+        int no = pilha.back().first, profundidade = pilha.back().second;
+        pilha.pop_back();
+        printLinha(string(2 * profundidade, ' ') + nos[no].nome, soma[no], proprio[no]);
+        for (int i = 0; i < filhosNo[no].size(); i++) pilha.push_back(make_pair(filhosNo[no][i], profundidade + 1));
+    }
+}
+
+ArvorePerfil::~ArvorePerfil() {
+    printRelatorio();
+}
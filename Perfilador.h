@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+
+using namespace std;
+
+// Perfilador por zonas. Cada PERFIL_ZONA("nome") mede, com o steady_clock, o tempo até o fim do escopo em que aparece.
+// As zonas são aninhadas pela ordem de execução e formam uma árvore única, compartilhada por todas as threads, na qual
+// cada nó é identificado pelo caminho de nomes desde a raiz. As estatísticas (chamadas, tempo total, mínimo e máximo)
+// são acumuladas em dados de cada thread, sem sincronização entre elas, e somadas somente no relatório, que é
+// impresso na saída de erro ao fim do programa em duas formas: plana, por nome de zona, e em árvore.
+// As tarefas executadas pelo PoolThreads herdam a zona de quem chamou paraCada, para que as zonas das threads do pool
+// apareçam dentro da zona que as disparou.
+// Quando GRAFOS_PERFIL não está definida, as macros não geram código algum
+struct DadosThread;
+
+class ZonaPerfil {
+private:
+    DadosThread *dados;
+    int anterior; // zona atual da thread antes desta zona
+    int no; // nó da árvore correspondente a esta zona
+    chrono::steady_clock::time_point inicio;
+public:
+    explicit ZonaPerfil(const char *nome);
+
+    ~ZonaPerfil();
+
+    // nó da árvore da zona atual da thread, 0 fora de qualquer zona
+    static int getZonaAtual();
+};
+
+// até o fim do escopo, as zonas abertas pela thread ficam dentro do nó passado, em geral a zona atual de outra thread
+class HerancaZonaPerfil {
+private:
+    DadosThread *dados;
+    int anterior;
+public:
+    explicit HerancaZonaPerfil(int no);
+
+    ~HerancaZonaPerfil();
+};
+
+#ifdef GRAFOS_PERFIL
+#define PERFIL_CONCATENAR_AUX(a, b) a##b
+#define PERFIL_CONCATENAR(a, b) PERFIL_CONCATENAR_AUX(a, b)
+#define PERFIL_ZONA(nome) ZonaPerfil PERFIL_CONCATENAR(zonaPerfil, __LINE__)(nome)
+#define PERFIL_ZONA_ATUAL() ZonaPerfil::getZonaAtual()
+#define PERFIL_HERDAR_ZONA(no) HerancaZonaPerfil PERFIL_CONCATENAR(herancaPerfil, __LINE__)(no)
+#else
+#define PERFIL_ZONA(nome)
+#define PERFIL_ZONA_ATUAL() 0
+#define PERFIL_HERDAR_ZONA(no)
+#endif
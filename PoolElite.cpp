@@ -0,0 +1,54 @@
+#include "PoolElite.h"
+#include <climits>
+#include <algorithm>
+
+PoolElite::PoolElite(int numNos, int capacidade, int distanciaMinima) {
+    palavras = (numNos + 63) / 64;
+    this->capacidade = capacidade;
+    this->distanciaMinima = distanciaMinima;
+}
+
+// número de nós em que as coberturas diferem
+int PoolElite::distancia(const vector<unsigned long long> &a, const vector<unsigned long long> &b) {
+    int d = 0;
+    for (int w = 0; w < palavras; w++) d += __builtin_popcountll(a[w] ^ b[w]);
+    return d;
+}
+
+bool PoolElite::inserir(const vector<unsigned long long> &bits, long long peso) {
+    long long melhor = LLONG_MAX;
+    int pior = -1;
+    int menorDistancia = INT_MAX;
+    for (int i = 0; i < elites.size(); i++) {
+        int d = distancia(bits, elites[i]);
+        if (d == 0) return false; // cobertura repetida
+        menorDistancia = min(menorDistancia, d);
+        melhor = min(melhor, pesos[i]);
+        if (pior == -1 || pesos[i] > pesos[pior]) pior = i;
+    }
+
+    bool melhorQueTodas = peso < melhor;
+    if (!melhorQueTodas && menorDistancia < distanciaMinima) return false;
+
+    if (elites.size() < capacidade) {
+        elites.push_back(bits);
+        pesos.push_back(peso);
+        return true;
+    }
+
+    if (peso >= pesos[pior]) return false;
+
+    // substitui a cobertura mais parecida entre as que não são melhores do que a nova
+    int substituida = -1, distanciaSubstituida = INT_MAX;
+    for (int i = 0; i < elites.size(); i++) {
+        if (pesos[i] < peso) continue;
+        int d = distancia(bits, elites[i]);
+        if (d < distanciaSubstituida) {
+            distanciaSubstituida = d;
+            substituida = i;
+        }
+    }
+    elites[substituida] = bits;
+    pesos[substituida] = peso;
+    return true;
+}
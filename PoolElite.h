@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+// Conjunto das melhores coberturas encontradas pelo GRASP, guardadas como bitsets sobre os índices dos nós.
+// Para manter a diversidade, uma cobertura só entra no conjunto quando difere em pelo menos distanciaMinima nós de
+// todas as coberturas guardadas, a menos que seja melhor do que todas elas. Com o conjunto cheio, a nova cobertura
+// precisa ser melhor do que a pior e substitui, entre as que não são melhores do que ela, a mais parecida
+class PoolElite {
+private:
+    int palavras;
+    int capacidade;
+    int distanciaMinima;
+    vector<vector<unsigned long long>> elites;
+    vector<long long> pesos;
+
+    int distancia(const vector<unsigned long long> &a, const vector<unsigned long long> &b);
+public:
+    PoolElite(int numNos, int capacidade, int distanciaMinima);
+
+    // tenta inserir a cobertura e retorna se ela entrou no conjunto
+    bool inserir(const vector<unsigned long long> &bits, long long peso);
+
+    int getTamanho() { return elites.size(); };
+
+    const vector<unsigned long long> &getBits(int i) { return elites[i]; };
+
+    long long getPeso(int i) { return pesos[i]; };
+};
@@ -0,0 +1,57 @@
+#include "PoolThreads.h"
+
+PoolThreads::PoolThreads(int numThreads) {
+    proximaTarefa = 0;
+    // a thread que chama paraCada também executa tarefas, portanto criamos uma thread a menos
+    for (int i = 1; i < numThreads; i++) threads.push_back(thread(&PoolThreads::trabalhar, this, i));
+}
+
+PoolThreads::~PoolThreads() {
+    {
+        lock_guard<mutex> lock(trava);
+        encerrar = true;
+    }
+    cvTarefa.notify_all();
+    for (int i = 0; i < threads.size(); i++) threads[i].join();
+}
+
+void PoolThreads::trabalhar(int idThread) {
+    int geracaoVista = 0;
+    while (true) {
+        unique_lock<mutex> lock(trava);
+        cvTarefa.wait(lock, [&]() { return encerrar || geracao != geracaoVista; });
+        if (encerrar) return;
+        geracaoVista = geracao;
+        lock.unlock();
+
+        executarTarefas(idThread);
+
+        lock.lock();
+        if (--threadsAtivas == 0) cvFim.notify_all();
+    }
+}
+
+void PoolThreads::executarTarefas(int idThread) {
+    PERFIL_HERDAR_ZONA(zonaPerfil);
+    int i;
+    while ((i = proximaTarefa++) < numTarefas) (*tarefa)(i, idThread);
+}
+
+void PoolThreads::paraCada(int numTarefas, const function<void(int, int)> &tarefa) {
+    lock_guard<mutex> execucao(travaExecucao);
+    {
+        lock_guard<mutex> lock(trava);
+        this->tarefa = &tarefa;
+        this->numTarefas = numTarefas;
+        zonaPerfil = PERFIL_ZONA_ATUAL();
+        proximaTarefa = 0;
+        threadsAtivas = threads.size();
+        geracao++;
+    }
+    cvTarefa.notify_all();
+
+    executarTarefas(0);
+
+    unique_lock<mutex> lock(trava);
+    cvFim.wait(lock, [this]() { return threadsAtivas == 0; });
+}
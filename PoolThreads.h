@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Perfilador.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+using namespace std;
+
+// Pool de threads persistente. As threads são criadas uma única vez e reaproveitadas em todas as chamadas de
+// paraCada, evitando o custo de criá-las a cada iteração dos algoritmos paralelos
+class PoolThreads {
+private:
+    vector<thread> threads;
+    mutex trava;
+    mutex travaExecucao; // garante que somente uma chamada de paraCada use o pool por vez
+    condition_variable cvTarefa;
+    condition_variable cvFim;
+
+    const function<void(int, int)> *tarefa = NULL;
+    int numTarefas = 0;
+    atomic<int> proximaTarefa;
+    int geracao = 0; // incrementada a cada chamada de paraCada para acordar as threads
+    int threadsAtivas = 0;
+    int zonaPerfil = 0; // zona do perfilador de quem chamou paraCada, herdada pelas tarefas
+    bool encerrar = false;
+
+    void trabalhar(int idThread);
+    void executarTarefas(int idThread);
+public:
+    PoolThreads(int numThreads);
+
+    ~PoolThreads();
+
+    // número de threads que executam as tarefas, contando a thread que chama paraCada
+    int getNumThreads() { return threads.size() + 1; };
+
+    // executa tarefa(i, idThread) para todo i em [0, numTarefas), distribuindo as tarefas dinamicamente entre as
+    // threads, e retorna quando todas tiverem terminado. idThread está em [0, getNumThreads()) e pode ser usado para
+    // indexar dados auxiliares de cada thread
+    void paraCada(int numTarefas, const function<void(int, int)> &tarefa);
+};
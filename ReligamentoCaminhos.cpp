@@ -0,0 +1,111 @@
+#include "ReligamentoCaminhos.h"
+
+void ReligamentoCaminhos::alterarGanho(int v, long long delta) {
+    ganho[v] += delta;
+    if (entrantes.contem(v)) entrantes.alterar(v, ganho[v] - g->getPeso(v));
+}
+
+// atualiza a contagem de vizinhos fora da cobertura de um nó que sai, mantendo o ganho do seu único vizinho fora.
+// Como a contagem dos nós que saem só diminui, um nó que chega a zero passa a poder sair até sair de fato
+void ReligamentoCaminhos::alterarVizinhosFora(int u, int novoValor) {
+    if (vizinhosFora[u] == 1) alterarGanho(unicoFora[u], -g->getPeso(u));
+    vizinhosFora[u] = novoValor;
+
+    if (novoValor == 1) {
+        for (const int *x = g->vizinhosBegin(u); x != g->vizinhosEnd(u); ++x) {
+            if (*x != u && !naCobertura[*x]) {
+                unicoFora[u] = *x;
+                break;
+            }
+        }
+        alterarGanho(unicoFora[u], g->getPeso(u));
+    }
+    if (novoValor == 0 && !removiveis.contem(u)) removiveis.inserir(u, g->getPeso(u));
+}
+
+void ReligamentoCaminhos::adicionar(int v) {
+    naCobertura[v] = true;
+    entra[v] = false;
+    entrantes.remover(v);
+    for (const int *u = g->vizinhosBegin(v); u != g->vizinhosEnd(v); ++u)
+        if (*u != v && sai[*u]) alterarVizinhosFora(*u, vizinhosFora[*u] - 1);
+}
+
+// só sai um nó sem vizinhos fora da cobertura, que não contribui para nenhum ganho
+void ReligamentoCaminhos::remover(int u) {
+    naCobertura[u] = false;
+    sai[u] = false;
+    removiveis.remover(u);
+}
+
+long long ReligamentoCaminhos::religar(GrafoCompacto *g, const vector<unsigned long long> &origem,
+                                 const vector<unsigned long long> &alvo, vector<int> *solucao) {
+    this->g = g;
+    int n = g->getNumNos();
+    naCobertura.assign(n, false);
+    sai.assign(n, false);
+    entra.assign(n, false);
+    vizinhosFora.assign(n, 0);
+    unicoFora.assign(n, -1);
+    ganho.assign(n, 0);
+    removiveis.reiniciar(n);
+    entrantes.reiniciar(n);
+    movimentos.clear();
+
+    vector<int> listaSai;
+    int numEntra = 0;
+    long long peso = 0;
+    for (int v = 0; v < n; v++) {
+        bool naOrigem = (origem[v / 64] >> (v % 64)) & 1;
+        bool noAlvo = (alvo[v / 64] >> (v % 64)) & 1;
+        naCobertura[v] = naOrigem;
+        if (naOrigem) peso += g->getPeso(v);
+        if (naOrigem && !noAlvo) {
+            sai[v] = true;
+            listaSai.push_back(v);
+        } else if (!naOrigem && noAlvo) {
+            entra[v] = true;
+            entrantes.inserir(v, -g->getPeso(v));
+            numEntra++;
+        }
+    }
+    for (int i = 0; i < listaSai.size(); i++) {
+        int u = listaSai[i];
+        int fora = 0;
+        for (const int *x = g->vizinhosBegin(u); x != g->vizinhosEnd(u); ++x)
+            if (*x != u && !naCobertura[*x]) fora++;
+        alterarVizinhosFora(u, fora);
+    }
+
+    // o último movimento chega ao alvo, portanto só os anteriores geram coberturas intermediárias
+    int numMovimentos = listaSai.size() + numEntra;
+    long long melhorPeso = -1;
+    int melhorPasso = -1;
+    for (int passo = 0; passo < numMovimentos - 1; passo++) {
+        int escolhido;
+        if (!removiveis.vazio()) {
+            escolhido = removiveis.topo();
+            remover(escolhido);
+            peso -= g->getPeso(escolhido);
+        } else {
+            escolhido = entrantes.topo();
+            adicionar(escolhido);
+            peso += g->getPeso(escolhido);
+        }
+
+        movimentos.push_back(escolhido);
+        if (melhorPasso == -1 || peso < melhorPeso) {
+            melhorPeso = peso;
+            melhorPasso = passo;
+        }
+    }
+    if (melhorPasso == -1) return -1;
+
+    // refaz os movimentos da origem até a melhor cobertura intermediária
+    for (int v = 0; v < n; v++) naCobertura[v] = (origem[v / 64] >> (v % 64)) & 1;
+    for (int i = 0; i <= melhorPasso; i++) naCobertura[movimentos[i]] = !naCobertura[movimentos[i]];
+    solucao->clear();
+    for (int v = 0; v < n; v++)
+        if (naCobertura[v]) solucao->push_back(v);
+    return melhorPeso;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "GrafoCompacto.h"
+#include "HeapIndexado.h"
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Religamento de caminhos entre duas coberturas: partindo da origem, os nós em que ela difere do alvo são trocados um
+// a um até chegar ao alvo, passando somente por coberturas válidas. Sempre que possível, sai o nó mais pesado que
+// pode sair sem descobrir arestas; caso contrário, entra o nó do alvo com o maior ganho, isto é, a soma dos pesos
+// dos nós que passariam a poder sair menos o seu próprio peso. Como o alvo é uma cobertura, depois que todos os nós
+// do alvo entram, todos os demais podem sair, portanto o caminho sempre chega ao alvo. Os vizinhos de um nó que sai
+// estão todos no alvo, portanto os seus vizinhos fora da cobertura são sempre nós que entram e as saídas não alteram
+// a contagem dos demais nós que saem.
+// Os nós que podem sair e os que entram ficam em heaps indexados, atualizados a cada movimento, portanto cada passo
+// custa O(log d), com d o número de nós em que as coberturas diferem, mais os graus dos nós envolvidos.
+// Cada thread deve usar o seu próprio objeto, que reaproveita os vectors entre as chamadas
+class ReligamentoCaminhos {
+private:
+    GrafoCompacto *g = NULL;
+    vector<bool> naCobertura;
+    vector<bool> sai; // nós da origem fora do alvo que ainda estão na cobertura
+    vector<bool> entra; // nós do alvo fora da origem que ainda não entraram na cobertura
+    vector<int> vizinhosFora; // para os nós que saem, número de vizinhos fora da cobertura
+    vector<int> unicoFora; // para os nós que saem com exatamente um vizinho fora da cobertura, guarda esse vizinho
+    // para os nós que entram, soma dos pesos dos nós que passariam a poder sair caso eles entrassem
+    vector<long long> ganho;
+    HeapIndexado removiveis; // nós que saem sem vizinhos fora da cobertura, pelo peso
+    HeapIndexado entrantes; // nós que entram, pelo ganho menos o próprio peso
+    vector<int> movimentos;
+
+    void alterarGanho(int v, long long delta);
+    void alterarVizinhosFora(int u, int novoValor);
+    void adicionar(int v);
+    void remover(int u);
+public:
+    // Percorre o caminho da origem ao alvo (bitsets sobre os índices dos nós) e guarda em solucao a melhor cobertura
+    // intermediária, retornando o seu peso. Retorna -1 quando o caminho não tem coberturas intermediárias
+    long long religar(GrafoCompacto *g, const vector<unsigned long long> &origem, const vector<unsigned long long> &alvo,
+                vector<int> *solucao);
+};
@@ -0,0 +1,250 @@
+#include "ServidorConsultas.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// consulta de um cliente e a sua resposta, preenchida pela thread que a executou
+struct Requisicao {
+    Consulta consulta;
+    string chave; // palavras da consulta separadas por um espaço, usada para agrupar consultas iguais
+    string resposta;
+    bool respondida = false;
+    mutex trava;
+    condition_variable cvResposta;
+};
+
+#define INTERVALO_VERIFICACAO_MS 200 // intervalo em que a espera por conexões verifica se o servidor foi encerrado
+
+static volatile sig_atomic_t sinalRecebido = 0;
+
+static void tratarSinal(int) {
+    sinalRecebido = 1;
+}
+
+// envia todos os bytes, retornando false caso o cliente tenha fechado a conexão
+static bool enviar(int conexao, const string &dados) {
+    size_t enviados = 0;
+    while (enviados < dados.size()) {
+        ssize_t n = send(conexao, dados.data() + enviados, dados.size() - enviados, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        enviados += n;
+    }
+    return true;
+}
+
+ServidorConsultas::ServidorConsultas(Grafo *grafo, string caminho) : interpretador(grafo) {
+    this->grafo = grafo;
+    this->caminho = caminho;
+    encerrado = false;
+}
+
+ServidorConsultas::~ServidorConsultas() {
+    if (descritor != -1) {
+        close(descritor);
+        unlink(caminho.c_str());
+    }
+}
+
+#pragma region Trava do grafo
+
+void ServidorConsultas::travarLeitura() {
+    unique_lock<mutex> lock(travaGrafo);
+    // novos leitores esperam as escritas pendentes, para que um fluxo contínuo de leituras não impeça as escritas
+    cvGrafo.wait(lock, [this]() { return !escrevendo && escritoresEsperando == 0; });
+    leitores++;
+}
+
+void ServidorConsultas::destravarLeitura() {
+    lock_guard<mutex> lock(travaGrafo);
+    if (--leitores == 0) cvGrafo.notify_all();
+}
+
+void ServidorConsultas::travarEscrita() {
+    unique_lock<mutex> lock(travaGrafo);
+    escritoresEsperando++;
+    cvGrafo.wait(lock, [this]() { return !escrevendo && leitores == 0; });
+    escritoresEsperando--;
+    escrevendo = true;
+}
+
+void ServidorConsultas::destravarEscrita() {
+    lock_guard<mutex> lock(travaGrafo);
+    escrevendo = false;
+    cvGrafo.notify_all();
+}
+
+#pragma endregion
+
+void ServidorConsultas::atenderConexao(int conexao) {
+    string pendente; // bytes recebidos que ainda não formam uma linha completa
+    char buffer[4096];
+    int linha = 0;
+    Requisicao requisicao;
+
+    while (!encerrado) {
+        size_t fimLinha = pendente.find('\n');
+        if (fimLinha == string::npos) {
+            ssize_t n = recv(conexao, buffer, sizeof(buffer), 0);
+            if (n <= 0) break;
+            pendente.append(buffer, n);
+            continue;
+        }
+        string texto = pendente.substr(0, fimLinha);
+        pendente.erase(0, fimLinha + 1);
+        if (!texto.empty() && texto.back() == '\r') texto.pop_back();
+
+        Consulta consulta = InterpretadorConsultas::analisar(++linha, texto);
+        if (consulta.argumentos.empty() || consulta.argumentos[0][0] == '#') continue;
+        if (consulta.argumentos.size() == 1 && consulta.argumentos[0] == "encerrar") {
+            enviar(conexao, InterpretadorConsultas::formatarResposta(consulta, "null", "") + "\n");
+            encerrar();
+            break;
+        }
+
+        requisicao.consulta = consulta;
+        requisicao.chave.clear();
+        for (int i = 0; i < consulta.argumentos.size(); i++) requisicao.chave += consulta.argumentos[i] + " ";
+        requisicao.respondida = false;
+        {
+            // depois do encerramento, os trabalhadores podem já ter terminado e nada mais é enfileirado
+            lock_guard<mutex> lock(travaFila);
+            if (encerrado) break;
+            fila.push_back(&requisicao);
+        }
+        cvFila.notify_one();
+
+        unique_lock<mutex> lock(requisicao.trava);
+        requisicao.cvResposta.wait(lock, [&requisicao]() { return requisicao.respondida; });
+        lock.unlock();
+        if (!enviar(conexao, requisicao.resposta + "\n")) break;
+    }
+
+    // o descritor só é fechado quando a thread é juntada, para que ele não seja reaproveitado por uma nova conexão
+    // enquanto ainda identifica esta
+    lock_guard<mutex> lock(travaConexoes);
+    conexoes.erase(conexao);
+    conexoesEncerradas.push_back(conexao);
+}
+
+void ServidorConsultas::juntarConexoesEncerradas() {
+    vector<int> encerradas;
+    {
+        lock_guard<mutex> lock(travaConexoes);
+        encerradas.swap(conexoesEncerradas);
+    }
+    for (int i = 0; i < encerradas.size(); i++) {
+        threadsConexoes[encerradas[i]].join();
+        threadsConexoes.erase(encerradas[i]);
+        close(encerradas[i]);
+    }
+}
+
+void ServidorConsultas::trabalhar() {
+    vector<Requisicao *> lote;
+    while (true) {
+        {
+            unique_lock<mutex> lock(travaFila);
+            cvFila.wait(lock, [this]() { return encerrado || !fila.empty(); });
+            if (fila.empty()) return;
+
+            // as consultas iguais à primeira da fila são retiradas junto com ela, exceto as que alteram o estado
+            lote.assign(1, fila.front());
+            fila.pop_front();
+            if (!InterpretadorConsultas::alteraEstado(lote[0]->consulta)) {
+                for (deque<Requisicao *>::iterator it = fila.begin(); it != fila.end();) {
+                    if ((*it)->chave == lote[0]->chave) {
+                        lote.push_back(*it);
+                        it = fila.erase(it);
+                    } else it++;
+                }
+            }
+        }
+
+        string erro, resultado;
+        bool concorrente = InterpretadorConsultas::ehConcorrente(lote[0]->consulta);
+        if (concorrente) travarLeitura();
+        else travarEscrita();
+        resultado = interpretador.executarComando(lote[0]->consulta, &erro);
+        if (concorrente) destravarLeitura();
+        else destravarEscrita();
+
+        for (int i = 0; i < lote.size(); i++) {
+            Requisicao *requisicao = lote[i];
+            lock_guard<mutex> lock(requisicao->trava);
+            requisicao->resposta = InterpretadorConsultas::formatarResposta(requisicao->consulta, resultado, erro);
+            requisicao->respondida = true;
+            requisicao->cvResposta.notify_one();
+        }
+    }
+}
+
+void ServidorConsultas::encerrar() {
+    encerrado = true;
+    {
+        // a trava da fila garante que nenhuma thread fique esperando por uma notificação já enviada
+        lock_guard<mutex> lock(travaFila);
+    }
+    cvFila.notify_all();
+    lock_guard<mutex> lock(travaConexoes);
+    for (set<int>::iterator it = conexoes.begin(); it != conexoes.end(); it++) shutdown(*it, SHUT_RDWR);
+}
+
+bool ServidorConsultas::executar(int numThreads) {
+    struct sockaddr_un endereco;
+    if (caminho.size() >= sizeof(endereco.sun_path)) {
+        cerr << "Caminho do socket muito longo: " << caminho << endl;
+        return false;
+    }
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho.c_str());
+
+    descritor = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(caminho.c_str()); // remove o socket deixado por uma execução anterior
+    if (descritor == -1 || bind(descritor, (struct sockaddr *) &endereco, sizeof(endereco)) != 0 ||
+        listen(descritor, SOMAXCONN) != 0) {
+        cerr << "Nao foi possivel criar o socket " << caminho << ": " << strerror(errno) << endl;
+        return false;
+    }
+
+    signal(SIGINT, tratarSinal);
+    signal(SIGTERM, tratarSinal);
+    vector<thread> trabalhadores;
+    for (int i = 0; i < numThreads; i++) trabalhadores.push_back(thread(&ServidorConsultas::trabalhar, this));
+    cerr << "Servidor escutando em " << caminho << endl;
+
+    while (!encerrado) {
+        if (sinalRecebido) {
+            encerrar();
+            break;
+        }
+        juntarConexoesEncerradas();
+        struct pollfd espera = {descritor, POLLIN, 0};
+        if (poll(&espera, 1, INTERVALO_VERIFICACAO_MS) <= 0) continue;
+        int conexao = accept(descritor, NULL, NULL);
+        if (conexao == -1) continue;
+
+        lock_guard<mutex> lock(travaConexoes);
+        if (encerrado) {
+            close(conexao);
+            break;
+        }
+        conexoes.insert(conexao);
+        threadsConexoes[conexao] = thread(&ServidorConsultas::atenderConexao, this, conexao);
+    }
+
+    // as threads das conexões terminam antes dos trabalhadores, pois as requisições que elas esperam ainda podem estar
+    // sendo executadas
+    while (!threadsConexoes.empty()) {
+        juntarConexoesEncerradas();
+        if (!threadsConexoes.empty()) this_thread::sleep_for(chrono::milliseconds(INTERVALO_VERIFICACAO_MS));
+    }
+    for (int i = 0; i < trabalhadores.size(); i++) trabalhadores[i].join();
+    cerr << "Servidor encerrado" << endl;
+    return true;
+}
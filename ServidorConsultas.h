@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Grafo.h"
+#include "InterpretadorConsultas.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+using namespace std;
+
+struct Requisicao;
+
+// Servidor de consultas sobre um socket Unix local, que mantém o grafo carregado entre as consultas. Cada cliente
+// envia consultas no formato do InterpretadorConsultas, uma por linha, e recebe uma resposta JSON por linha, na ordem
+// em que enviou. Cada conexão tem uma thread que lê as consultas e espera a resposta da anterior antes de enfileirar a
+// próxima, o que mantém a ordem das edições de um mesmo cliente. As consultas enfileiradas são executadas por um
+// grupo fixo de threads: as concorrentes sob a trava de leitura do grafo e as demais sob a trava de escrita, que dá
+// preferência às escritas para que elas não esperem indefinidamente. Consultas iguais que não alteram o estado e
+// estão na fila ao mesmo tempo são executadas uma única vez e a resposta é enviada a todos os clientes que as pediram.
+// A consulta encerrar, SIGINT ou SIGTERM param o servidor
+class ServidorConsultas {
+private:
+    Grafo *grafo;
+    InterpretadorConsultas interpretador;
+    string caminho;
+    int descritor = -1;
+    atomic<bool> encerrado;
+
+    // fila de requisições ainda não executadas
+    mutex travaFila;
+    condition_variable cvFila;
+    deque<Requisicao *> fila;
+
+    // trava de leitura e escrita do grafo
+    mutex travaGrafo;
+    condition_variable cvGrafo;
+    int leitores = 0;
+    bool escrevendo = false;
+    int escritoresEsperando = 0;
+
+    // conexões abertas, interrompidas no encerramento para acordar as threads bloqueadas na leitura, e conexões cujas
+    // threads já terminaram e ainda precisam ser juntadas. As threads são indexadas pelo descritor da conexão
+    mutex travaConexoes;
+    set<int> conexoes;
+    vector<int> conexoesEncerradas;
+    map<int, thread> threadsConexoes;
+
+    void travarLeitura();
+    void destravarLeitura();
+    void travarEscrita();
+    void destravarEscrita();
+
+    void atenderConexao(int conexao);
+    void juntarConexoesEncerradas();
+    void trabalhar();
+    void encerrar();
+public:
+    ServidorConsultas(Grafo *grafo, string caminho);
+
+    ~ServidorConsultas();
+
+    // atende os clientes até o servidor ser encerrado, com numThreads threads executando as consultas. Retorna false
+    // caso não seja possível criar o socket
+    bool executar(int numThreads);
+};
@@ -0,0 +1,33 @@
+#include "SolucaoCobertura.h"
+#include <algorithm>
+
+// valor aleatório de cada nó no hash de Zobrist, obtido pelo misturador do splitmix64
+static unsigned long long valorZobrist(int v) {
+    unsigned long long x = (unsigned long long) v + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+void SolucaoCobertura::reiniciar(int numNos) {
+    nos.clear();
+    bits.assign((numNos + 63) / 64, 0);
+    peso = 0;
+    hash = 0;
+}
+
+void SolucaoCobertura::adicionar(int v, long long pesoNo) {
+    nos.push_back(v);
+    bits[v / 64] |= 1ULL << (v % 64);
+    peso += pesoNo;
+    hash ^= valorZobrist(v);
+}
+
+void SolucaoCobertura::recalcular() {
+    fill(bits.begin(), bits.end(), 0ULL);
+    hash = 0;
+    for (int i = 0; i < nos.size(); i++) {
+        bits[nos[i] / 64] |= 1ULL << (nos[i] % 64);
+        hash ^= valorZobrist(nos[i]);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+// Cobertura de vértices guardada ao mesmo tempo como lista de nós e como bitset sobre os índices dos nós, junto com o
+// seu peso e um hash de Zobrist (xor de um valor aleatório por nó), usado para detectar coberturas repetidas. Os objetos
+// são reaproveitados entre as iterações: reiniciar mantém a capacidade dos vectors, de forma que uma mesma cobertura
+// não realoque memória a cada construção
+struct SolucaoCobertura {
+    vector<int> nos;
+    vector<unsigned long long> bits;
+    long long peso = 0;
+    unsigned long long hash = 0;
+
+    void reiniciar(int numNos);
+
+    void adicionar(int v, long long pesoNo);
+
+    bool contem(int v) const { return (bits[v / 64] >> (v % 64)) & 1; };
+
+    // reconstrói o bitset e o hash a partir da lista de nós, depois que ela é alterada diretamente
+    void recalcular();
+};
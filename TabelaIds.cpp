@@ -0,0 +1,70 @@
+#include "TabelaIds.h"
+#include <functional>
+
+#define VAZIO -1
+#define REMOVIDO -2
+// capacidade inicial da tabela, uma potência de 2
+#define CAPACIDADE_INICIAL_IDS 16
+// a tabela dobra quando as posições ocupadas, contando as removidas, passam de NUMERADOR / DENOMINADOR da capacidade
+#define CARGA_MAXIMA_NUMERADOR 7
+#define CARGA_MAXIMA_DENOMINADOR 10
+
+TabelaIds::TabelaIds() {
+    entradas = vector<EntradaId>(CAPACIDADE_INICIAL_IDS, {string_view(), VAZIO});
+}
+
+// posição do id na tabela, ou a primeira posição vazia da sua sondagem quando ele não está na tabela
+int TabelaIds::posicao(string_view id) const {
+    int mascara = entradas.size() - 1;
+    int i = hash<string_view>()(id) & mascara;
+    while (entradas[i].indice != VAZIO) {
+        if (entradas[i].indice != REMOVIDO && entradas[i].id == id) return i;
+        i = (i + 1) & mascara;
+    }
+    return i;
+}
+
+// reconstrói a tabela com a nova capacidade, descartando as posições removidas
+void TabelaIds::redimensionar(int capacidade) {
+    vector<EntradaId> antigas(capacidade, {string_view(), VAZIO});
+    antigas.swap(entradas);
+    numOcupadas = numIds;
+    for (int i = 0; i < antigas.size(); i++)
+        if (antigas[i].indice >= 0) entradas[posicao(antigas[i].id)] = antigas[i];
+}
+
+// as posições vazias têm índice VAZIO, que é o -1 devolvido para os ids inexistentes
+int TabelaIds::buscar(string_view id) const {
+    return entradas[posicao(id)].indice;
+}
+
+void TabelaIds::inserir(string_view id, int indice) {
+    int i = posicao(id);
+    if (entradas[i].indice != VAZIO) {
+        entradas[i].indice = indice;
+        return;
+    }
+    entradas[i] = {id, indice};
+    numIds++;
+    numOcupadas++;
+    if ((long long) numOcupadas * CARGA_MAXIMA_DENOMINADOR > (long long) entradas.size() * CARGA_MAXIMA_NUMERADOR) {
+        // quando a maior parte das posições ocupadas foi removida, basta limpá-las, sem dobrar a tabela
+        redimensionar(numIds * 2 > numOcupadas ? entradas.size() * 2 : entradas.size());
+    }
+}
+
+bool TabelaIds::remover(string_view id) {
+    int i = posicao(id);
+    if (entradas[i].indice == VAZIO) return false;
+    // a posição não pode voltar a ser vazia, pois interromperia as sondagens dos ids inseridos depois dela
+    entradas[i].indice = REMOVIDO;
+    numIds--;
+    return true;
+}
+
+void TabelaIds::reservar(int numIds) {
+    int capacidade = entradas.size();
+    while ((long long) numIds * CARGA_MAXIMA_DENOMINADOR > (long long) capacidade * CARGA_MAXIMA_NUMERADOR)
+        capacidade *= 2;
+    if (capacidade != entradas.size()) redimensionar(capacidade);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// posição da tabela de ids. O índice é VAZIO nas posições nunca usadas e REMOVIDO nas que tiveram o id excluído
+struct EntradaId {
+    string_view id;
+    int indice;
+};
+
+// Tabela hash de endereçamento aberto, com sondagem linear, que associa o id de cada nó ao seu índice. As chaves são
+// string_views para os ids guardados na ArenaStrings do grafo, portanto a tabela não copia os ids e todas as entradas
+// ficam em um único vector. A capacidade é sempre uma potência de 2
+class TabelaIds {
+private:
+    vector<EntradaId> entradas;
+    int numIds = 0;
+    int numOcupadas = 0; // ids mais posições removidas, que também alongam as sondagens
+
+    int posicao(string_view id) const;
+    void redimensionar(int capacidade);
+public:
+    TabelaIds();
+
+    // índice do nó com o id, ou -1 quando ele não existe
+    int buscar(string_view id) const;
+
+    // associa o id ao índice, substituindo o índice anterior quando o id já existe. O id precisa continuar válido
+    // enquanto estiver na tabela
+    void inserir(string_view id, int indice);
+
+    // retorna false quando o id não existe
+    bool remover(string_view id);
+
+    // prepara a tabela para receber numIds ids sem redimensionar
+    void reservar(int numIds);
+
+    int size() const { return numIds; };
+};
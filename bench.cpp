@@ -0,0 +1,411 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "Grafo.h"
+
+using namespace std;
+
+// Benchmark dos algoritmos do trabalho, que refaz as medições do dadosRelatorio sem passar pelos menus. Os algoritmos
+// de cobertura rodam sobre as instâncias MWVC e os algoritmos da primeira fase sobre as instâncias da fase 1, para
+// cada combinação de semente, número de threads e repetição. Cada execução roda em um processo filho, de forma que o
+// pico de memória (RSS) medido seja somente o da execução, e a saída dos algoritmos é descartada
+
+const vector<string> ALGORITMOS_COBERTURA = {"guloso", "randomizado", "reativo", "primal-dual", "exato"};
+const vector<string> ALGORITMOS_FASE1 = {"kruskal", "boruvka", "pontes", "articulacao", "componentes"};
+
+struct ConfiguracaoBench {
+    string mwvc = "instancias MWVC";
+    string fase1 = "instancias Grafos fase 1";
+    vector<string> algoritmos; // vazio para todos
+    int repeticoes = 1;
+    vector<unsigned long long> sementes = {1};
+    vector<int> threads = {1};
+    double alfa = 0.3;
+    int iteracoes = 100;
+    int blocoReativo = 10;
+    double tempoLimite = 0; // tempo limite dos GRASPs, 0 para limitar pelo número de iterações
+    double tempoLimiteExato = 60; // tempo limite da cobertura exata, 0 para não limitar
+    string ordemNos; // reordenação dos nós após a leitura (rcm, grau ou largura), vazia para a ordem do arquivo
+    string formato = "csv";
+    string saida; // vazio para a saída padrão
+};
+
+struct Execucao {
+    string instancia;
+    string algoritmo;
+    unsigned long long semente;
+    int threads;
+    int repeticao;
+};
+
+struct Resultado {
+    bool sucesso = false;
+    double tempoLeitura = 0; // segundos de parede da leitura do arquivo
+    double tempoParede = 0; // segundos de parede do algoritmo
+    double tempoCpu = 0; // segundos de CPU do algoritmo, somando todas as threads
+    long picoRss = 0; // pico de memória residente do processo, em KB
+    string qualidade; // peso da solução ou da AGM, ou tamanho do resultado (pontes, nós de articulação, componentes)
+    string limiteInferior; // limite inferior da relaxação linear, somente na cobertura
+    string observacao;
+};
+
+#pragma region Argumentos
+
+static vector<string> separar(const string &lista) {
+    vector<string> partes;
+    string parte;
+    istringstream iss(lista);
+    while (getline(iss, parte, ',')) {
+        if (!parte.empty()) partes.push_back(parte);
+    }
+    return partes;
+}
+
+static void printUso(const char *programa) {
+    cerr << "Usage: " << programa << " [opcoes]\n"
+         << "  --mwvc <dir|arquivo>        instancias da cobertura (\"\" para nenhuma)\n"
+         << "  --fase1 <dir|arquivo>       instancias da fase 1 (\"\" para nenhuma)\n"
+         << "  --algoritmos <a,b,...>      cobertura: guloso,randomizado,reativo,primal-dual,exato\n"
+         << "                              fase 1: kruskal,boruvka,pontes,articulacao,componentes\n"
+         << "  --repeticoes <n>            repeticoes de cada combinacao (padrao 1)\n"
+         << "  --sementes <s1,s2,...>      sementes dos algoritmos randomizados (padrao 1)\n"
+         << "  --threads <t1,t2,...>       numeros de threads (padrao 1)\n"
+         << "  --alfa <a>                  alfa do guloso randomizado (padrao 0.3)\n"
+         << "  --iteracoes <n>             iteracoes dos GRASPs (padrao 100)\n"
+         << "  --bloco <n>                 bloco de iteracoes do reativo (padrao 10)\n"
+         << "  --tempo <s>                 tempo limite dos GRASPs, ignorando as iteracoes (padrao 0)\n"
+         << "  --tempo-exato <s>           tempo limite da cobertura exata, 0 para nao limitar (padrao 60)\n"
+         << "  --ordem <rcm|grau|largura>  reordena os nos apos a leitura (padrao: ordem do arquivo)\n"
+         << "  --formato <csv|json>        formato da saida (padrao csv)\n"
+         << "  --saida <arquivo>           arquivo de saida (padrao: saida padrao)\n";
+}
+
+// retorna false caso algum argumento seja inválido
+static bool lerArgumentos(int argc, char **argv, ConfiguracaoBench *c) {
+    for (int i = 1; i < argc; i++) {
+        string opcao = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Falta o valor da opcao " << opcao << "\n";
+            return false;
+        }
+        string valor = argv[++i];
+
+        if (opcao == "--mwvc") c->mwvc = valor;
+        else if (opcao == "--fase1") c->fase1 = valor;
+        else if (opcao == "--algoritmos") c->algoritmos = separar(valor);
+        else if (opcao == "--repeticoes") c->repeticoes = atoi(valor.c_str());
+        else if (opcao == "--sementes") {
+            c->sementes.clear();
+            for (const string &s : separar(valor)) c->sementes.push_back(strtoull(s.c_str(), NULL, 10));
+        } else if (opcao == "--threads") {
+            c->threads.clear();
+            for (const string &t : separar(valor)) c->threads.push_back(atoi(t.c_str()));
+        } else if (opcao == "--alfa") c->alfa = atof(valor.c_str());
+        else if (opcao == "--iteracoes") c->iteracoes = atoi(valor.c_str());
+        else if (opcao == "--bloco") c->blocoReativo = atoi(valor.c_str());
+        else if (opcao == "--tempo") c->tempoLimite = atof(valor.c_str());
+        else if (opcao == "--tempo-exato") c->tempoLimiteExato = atof(valor.c_str());
+        else if (opcao == "--ordem") c->ordemNos = valor;
+        else if (opcao == "--formato") c->formato = valor;
+        else if (opcao == "--saida") c->saida = valor;
+        else {
+            cerr << "Opcao desconhecida: " << opcao << "\n";
+            return false;
+        }
+    }
+
+    for (const string &a : c->algoritmos) {
+        if (find(ALGORITMOS_COBERTURA.begin(), ALGORITMOS_COBERTURA.end(), a) == ALGORITMOS_COBERTURA.end() &&
+            find(ALGORITMOS_FASE1.begin(), ALGORITMOS_FASE1.end(), a) == ALGORITMOS_FASE1.end()) {
+            cerr << "Algoritmo desconhecido: " << a << "\n";
+            return false;
+        }
+    }
+    for (int t : c->threads) {
+        if (t <= 0) {
+            cerr << "Numero de threads invalido: " << t << "\n";
+            return false;
+        }
+    }
+    if (c->repeticoes <= 0 || c->iteracoes <= 0 || c->blocoReativo <= 0 || c->sementes.empty() ||
+        c->threads.empty() || c->alfa < 0 || c->alfa > 1 || (c->formato != "csv" && c->formato != "json") ||
+        (!c->ordemNos.empty() && c->ordemNos != "rcm" && c->ordemNos != "grau" && c->ordemNos != "largura")) {
+        cerr << "Argumentos invalidos\n";
+        return false;
+    }
+    return true;
+}
+
+// lista os arquivos .txt de um diretório em ordem alfabética. Quando o caminho é um arquivo, retorna somente ele
+static vector<string> listarInstancias(const string &caminho) {
+    vector<string> instancias;
+    if (caminho.empty()) return instancias;
+
+    struct stat info;
+    if (stat(caminho.c_str(), &info) != 0) {
+        cerr << "Instancias nao encontradas: " << caminho << "\n";
+        return instancias;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        instancias.push_back(caminho);
+        return instancias;
+    }
+
+    DIR *dir = opendir(caminho.c_str());
+    if (dir == NULL) return instancias;
+    struct dirent *entrada;
+    while ((entrada = readdir(dir)) != NULL) {
+        string nome = entrada->d_name;
+        if (nome.size() > 4 && nome.compare(nome.size() - 4, 4, ".txt") == 0) instancias.push_back(caminho + "/" + nome);
+    }
+    closedir(dir);
+    sort(instancias.begin(), instancias.end());
+    return instancias;
+}
+
+#pragma endregion
+
+#pragma region Execucao
+
+static double segundos(const struct timeval &t) {
+    return t.tv_sec + t.tv_usec / 1e6;
+}
+
+static double tempoCpu() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return segundos(uso.ru_utime) + segundos(uso.ru_stime);
+}
+
+// executa o algoritmo no processo atual. A saída dos algoritmos é descartada, para que não pese nas medições
+static Resultado executarAlgoritmo(const ConfiguracaoBench &c, const Execucao &e) {
+    Resultado r;
+    cout.setstate(ios::failbit);
+
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    Grafo *grafo = new Grafo(e.instancia, "");
+    // a reordenação faz parte da preparação do grafo e é medida junto com a leitura
+    if (!c.ordemNos.empty()) grafo->reordenarNos(c.ordemNos);
+    r.tempoLeitura = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    grafo->setSemente(e.semente);
+    grafo->setNumThreads(e.threads);
+
+    double cpuInicio = tempoCpu();
+    inicio = chrono::steady_clock::now();
+    pair<vector<int>, long long> solucao(vector<int>(), -1);
+    int pesoAGM = -1;
+    int quantidade = -1; // tamanho do resultado dos algoritmos estruturais
+    if (e.algoritmo == "guloso") {
+        solucao = grafo->construirSolucaoGulosa();
+    } else if (e.algoritmo == "randomizado") {
+        solucao = grafo->construirSolucaoRandomizada(c.alfa, c.iteracoes, c.tempoLimite);
+    } else if (e.algoritmo == "reativo") {
+        vector<alphaProb> alphaProbs;
+        solucao = grafo->construirSolucaoReativa(c.iteracoes, c.blocoReativo, c.tempoLimite, &alphaProbs);
+    } else if (e.algoritmo == "primal-dual") {
+        long long limiteEmpacotamento;
+        solucao = grafo->construirSolucaoPrimalDual(&limiteEmpacotamento);
+    } else if (e.algoritmo == "exato") {
+        bool otima;
+        long long nosExplorados;
+        if (!grafo->construirSolucaoExata(c.tempoLimiteExato, &solucao, &otima, &nosExplorados))
+            r.observacao = "grafo reduzido grande demais";
+        else r.observacao = otima ? "otima" : "interrompida";
+    } else if (e.algoritmo == "kruskal" || e.algoritmo == "boruvka") {
+        pesoAGM = grafo->pesoArvoreGeradoraMinima(e.algoritmo == "boruvka");
+    } else if (e.algoritmo == "pontes") {
+        quantidade = grafo->getArestasPonte().size();
+    } else if (e.algoritmo == "articulacao") {
+        quantidade = grafo->getNosArticulacao().size();
+    } else if (e.algoritmo == "componentes") {
+        grafo->getComponentesFortementeConexas(&quantidade, NULL);
+    }
+    r.tempoParede = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    r.tempoCpu = tempoCpu() - cpuInicio;
+
+    // o limite inferior é calculado fora da medição, pois só os GRASPs e o exato o usam
+    if (solucao.second != -1) {
+        r.qualidade = to_string(solucao.second);
+        r.limiteInferior = to_string(grafo->getLimiteInferiorCobertura());
+    }
+    if (pesoAGM != -1) r.qualidade = to_string(pesoAGM);
+    if (quantidade != -1) r.qualidade = to_string(quantidade);
+    r.sucesso = true;
+
+    delete (grafo);
+    cout.clear();
+    return r;
+}
+
+// executa o algoritmo em um processo filho, que devolve o resultado por um pipe. O pico de memória e o estado de saída
+// do filho são obtidos pelo wait4
+static Resultado executarEmProcessoFilho(const ConfiguracaoBench &c, const Execucao &e) {
+    Resultado r;
+    int canal[2];
+    if (pipe(canal) != 0) {
+        r.observacao = "falha ao criar pipe";
+        return r;
+    }
+
+    cout.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(canal[0]);
+        close(canal[1]);
+        r.observacao = "falha ao criar processo";
+        return r;
+    }
+
+    if (pid == 0) {
+        close(canal[0]);
+        Resultado filho = executarAlgoritmo(c, e);
+        // campos separados por tabulação, sem espaços nos valores
+        string linha = to_string(filho.tempoLeitura) + "\t" + to_string(filho.tempoParede) + "\t" +
+                       to_string(filho.tempoCpu) + "\t" + (filho.qualidade.empty() ? "-" : filho.qualidade) + "\t" +
+                       (filho.limiteInferior.empty() ? "-" : filho.limiteInferior) + "\t" +
+                       (filho.observacao.empty() ? "-" : filho.observacao) + "\n";
+        ssize_t escrito = write(canal[1], linha.c_str(), linha.size());
+        close(canal[1]);
+        _exit(escrito == (ssize_t) linha.size() ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(canal[1]);
+    string linha;
+    char buffer[512];
+    ssize_t lido;
+    while ((lido = read(canal[0], buffer, sizeof(buffer))) > 0) linha.append(buffer, lido);
+    close(canal[0]);
+
+    int status;
+    struct rusage uso;
+    wait4(pid, &status, 0, &uso);
+    r.picoRss = uso.ru_maxrss;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+        r.observacao = WIFSIGNALED(status) ? "terminado pelo sinal " + to_string(WTERMSIG(status)) : "falhou";
+        return r;
+    }
+
+    istringstream iss(linha);
+    iss >> r.tempoLeitura >> r.tempoParede >> r.tempoCpu >> r.qualidade >> r.limiteInferior;
+    getline(iss >> ws, r.observacao);
+    if (r.qualidade == "-") r.qualidade.clear();
+    if (r.limiteInferior == "-") r.limiteInferior.clear();
+    if (r.observacao == "-") r.observacao.clear();
+    r.sucesso = true;
+    return r;
+}
+
+#pragma endregion
+
+#pragma region Saida
+
+static string escaparCsv(const string &s) {
+    if (s.find_first_of(",\"\n") == string::npos) return s;
+    string escapado = "\"";
+    for (char ch : s) {
+        if (ch == '"') escapado += '"';
+        escapado += ch;
+    }
+    return escapado + "\"";
+}
+
+static string escaparJson(const string &s) {
+    string escapado = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') escapado += '\\';
+        escapado += ch;
+    }
+    return escapado + "\"";
+}
+
+static void printCabecalho(ostream &out, const string &formato) {
+    if (formato == "csv")
+        out << "instancia,algoritmo,threads,semente,repeticao,sucesso,tempo_leitura_s,tempo_parede_s,tempo_cpu_s,"
+               "pico_rss_kb,qualidade,limite_inferior,observacao\n";
+    else out << "[\n";
+}
+
+static void printResultado(ostream &out, const string &formato, const Execucao &e, const Resultado &r,
+                           bool primeiro) {
+    if (formato == "csv") {
+        out << escaparCsv(e.instancia) << "," << e.algoritmo << "," << e.threads << "," << e.semente << ","
+            << e.repeticao << "," << (r.sucesso ? 1 : 0) << "," << r.tempoLeitura << "," << r.tempoParede << ","
+            << r.tempoCpu << "," << r.picoRss << "," << r.qualidade << "," << r.limiteInferior << ","
+            << escaparCsv(r.observacao) << "\n";
+    } else {
+        if (!primeiro) out << ",\n";
+        out << "  {\"instancia\": " << escaparJson(e.instancia) << ", \"algoritmo\": " << escaparJson(e.algoritmo)
+            << ", \"threads\": " << e.threads << ", \"semente\": " << e.semente << ", \"repeticao\": " << e.repeticao
+            << ", \"sucesso\": " << (r.sucesso ? "true" : "false") << ", \"tempo_leitura_s\": " << r.tempoLeitura
+            << ", \"tempo_parede_s\": " << r.tempoParede << ", \"tempo_cpu_s\": " << r.tempoCpu
+            << ", \"pico_rss_kb\": " << r.picoRss
+            << ", \"qualidade\": " << (r.qualidade.empty() ? "null" : r.qualidade)
+            << ", \"limite_inferior\": " << (r.limiteInferior.empty() ? "null" : r.limiteInferior)
+            << ", \"observacao\": " << escaparJson(r.observacao) << "}";
+    }
+    out.flush();
+}
+
+static void printRodape(ostream &out, const string &formato) {
+    if (formato == "json") out << "\n]\n";
+}
+
+#pragma endregion
+
+int main(int argc, char **argv) {
+    ConfiguracaoBench c;
+    if (!lerArgumentos(argc, argv, &c)) {
+        printUso(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    // os algoritmos de cada grupo rodam somente nas instâncias do grupo
+    vector<Execucao> execucoes;
+    vector<pair<vector<string>, const vector<string> *>> grupos = {
+            make_pair(listarInstancias(c.mwvc), &ALGORITMOS_COBERTURA),
+            make_pair(listarInstancias(c.fase1), &ALGORITMOS_FASE1)};
+    for (auto &grupo : grupos) {
+        for (const string &instancia : grupo.first) {
+            for (const string &algoritmo : *grupo.second) {
+                if (!c.algoritmos.empty() &&
+                    find(c.algoritmos.begin(), c.algoritmos.end(), algoritmo) == c.algoritmos.end())
+                    continue;
+                for (int threads : c.threads)
+                    for (unsigned long long semente : c.sementes)
+                        for (int repeticao = 1; repeticao <= c.repeticoes; repeticao++)
+                            execucoes.push_back({instancia, algoritmo, semente, threads, repeticao});
+            }
+        }
+    }
+
+    ofstream arquivo;
+    if (!c.saida.empty()) {
+        arquivo.open(c.saida);
+        if (!arquivo.is_open()) {
+            cerr << "Nao foi possivel escrever no arquivo " << c.saida << "\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+    ostream &out = c.saida.empty() ? cout : arquivo;
+
+    printCabecalho(out, c.formato);
+    for (int i = 0; i < execucoes.size(); i++) {
+        const Execucao &e = execucoes[i];
+        cerr << "[" << i + 1 << "/" << execucoes.size() << "] " << e.instancia << " " << e.algoritmo << " (threads "
+             << e.threads << ", semente " << e.semente << ", repeticao " << e.repeticao << ")\n";
+        printResultado(out, c.formato, e, executarEmProcessoFilho(c, e), i == 0);
+    }
+    printRodape(out, c.formato);
+    return 0;
+}
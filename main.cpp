@@ -1,7 +1,12 @@
 #include <iostream>
 #include <vector>
 #include <climits>
+#include <fstream>
 #include "Grafo.h"
+#include "InterpretadorConsultas.h"
+#ifndef _WIN32
+#include "ServidorConsultas.h"
+#endif
 
 
 using namespace std;
@@ -24,25 +29,123 @@ void showInfoVerificaInfoGrafoMenu();
 
 void showCoberturaMenu();
 
+void showMetricasMenu();
+
+void salvarMetricas(string nomeArquivo);
+
+Grafo *carregarGrafo(string arquivoEntrada, string arquivoSaida, string ordemNos);
+
+int executarLote(string arquivoEntrada, string arquivoSaida, string ordemNos, string arquivoConsultas,
+                 string arquivoMetricas);
+
+int executarServidor(string arquivoEntrada, string arquivoSaida, string ordemNos, string caminhoSocket,
+                     string arquivoMetricas);
+
 Grafo *grafo;
 
 int main(int argc, char **argv) {
 
-    if (argc != 3) {
-        cout << "Usage: " << argv[0] << " <nome do arquivo de entrada> <nome do arquivo de saida>\n";
+    // com --metrics, a contagem das métricas fica ligada desde o início e o retrato é salvo no arquivo informado ao sair.
+    // Com --batch, as consultas do arquivo (ou da entrada padrão, quando o nome é -) são executadas no lugar dos menus
+    // e, com --server, as consultas são recebidas pelo socket Unix informado. Com --reorder, os nós são reordenados
+    // depois da leitura (rcm, grau ou largura) para que nós vizinhos fiquem próximos na memória
+    string arquivoMetricas, arquivoConsultas, caminhoSocket, ordemNos;
+    bool argumentosValidos = argc >= 3 && argc % 2 == 1;
+    for (int i = 3; argumentosValidos && i < argc; i += 2) {
+        string opcao = argv[i];
+        if (opcao == "--metrics") arquivoMetricas = argv[i + 1];
+        else if (opcao == "--batch") arquivoConsultas = argv[i + 1];
+        else if (opcao == "--reorder") ordemNos = argv[i + 1];
+#ifndef _WIN32
+        else if (opcao == "--server") caminhoSocket = argv[i + 1];
+#endif
+        else argumentosValidos = false;
+    }
+    if (!argumentosValidos || (!arquivoConsultas.empty() && !caminhoSocket.empty())) {
+        cout << "Usage: " << argv[0] << " <nome do arquivo de entrada> <nome do arquivo de saida>"
+             << " [--metrics <arquivo de metricas>] [--reorder <rcm|grau|largura>]"
+             << " [--batch <arquivo de consultas> | --server <socket>]\n";
         exit(EXIT_FAILURE);
     }
 
-    grafo = new Grafo(argv[1], argv[2]);
+    if (!arquivoConsultas.empty())
+        return executarLote(argv[1], argv[2], ordemNos, arquivoConsultas, arquivoMetricas);
+    if (!caminhoSocket.empty()) return executarServidor(argv[1], argv[2], ordemNos, caminhoSocket, arquivoMetricas);
+
+    grafo = carregarGrafo(argv[1], argv[2], ordemNos);
+    if (!arquivoMetricas.empty()) grafo->getMetricas()->setAtivas(true);
 
     showMainMenu(); //Exibir Menu Principal
 
     grafo->salvarArquivo();
+    if (!arquivoMetricas.empty()) salvarMetricas(arquivoMetricas);
+
+    delete (grafo);
+    return 0;
+}
 
+// lê o grafo e, quando uma ordem é informada, reordena os seus nós. Uma ordem desconhecida encerra o programa
+Grafo *carregarGrafo(string arquivoEntrada, string arquivoSaida, string ordemNos) {
+    Grafo *g = new Grafo(arquivoEntrada, arquivoSaida);
+    if (!ordemNos.empty() && !g->reordenarNos(ordemNos)) {
+        cerr << "Ordem de nos desconhecida: " << ordemNos << " (use rcm, grau ou largura)\n";
+        exit(EXIT_FAILURE);
+    }
+    return g;
+}
+
+// No modo em lote, somente as respostas das consultas, uma linha JSON por consulta, vão para a saída padrão. As
+// mensagens do grafo são descartadas e nada é perguntado ao usuário. O grafo só é salvo pela consulta salvar
+int executarLote(string arquivoEntrada, string arquivoSaida, string ordemNos, string arquivoConsultas,
+                 string arquivoMetricas) {
+    ifstream arquivo;
+    if (arquivoConsultas != "-") {
+        arquivo.open(arquivoConsultas);
+        if (!arquivo.is_open()) {
+            cerr << "Nao foi possivel abrir o arquivo de consultas " << arquivoConsultas << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    ostream saida(cout.rdbuf());
+    cout.setstate(ios::failbit);
+    grafo = carregarGrafo(arquivoEntrada, arquivoSaida, ordemNos);
+    grafo->setInterativo(false);
+    if (!arquivoMetricas.empty()) grafo->getMetricas()->setAtivas(true);
+
+    InterpretadorConsultas interpretador(grafo);
+    if (arquivoConsultas == "-") interpretador.executarLote(cin, saida);
+    else interpretador.executarLote(arquivo, saida);
+
+    if (!arquivoMetricas.empty()) salvarMetricas(arquivoMetricas);
     delete (grafo);
+    cout.clear();
     return 0;
 }
 
+// O servidor, como o modo em lote, descarta as mensagens do grafo e não pergunta nada ao usuário. Somente o início e o
+// fim do servidor são informados, na saída de erro
+int executarServidor(string arquivoEntrada, string arquivoSaida, string ordemNos, string caminhoSocket,
+                     string arquivoMetricas) {
+#ifdef _WIN32
+    return EXIT_FAILURE;
+#else
+    cout.setstate(ios::failbit);
+    grafo = carregarGrafo(arquivoEntrada, arquivoSaida, ordemNos);
+    grafo->setInterativo(false);
+    if (!arquivoMetricas.empty()) grafo->getMetricas()->setAtivas(true);
+
+    ServidorConsultas *servidor = new ServidorConsultas(grafo, caminhoSocket);
+    bool sucesso = servidor->executar(grafo->getNumThreads());
+    delete (servidor);
+
+    if (sucesso && !arquivoMetricas.empty()) salvarMetricas(arquivoMetricas);
+    delete (grafo);
+    cout.clear();
+    return sucesso ? 0 : EXIT_FAILURE;
+#endif
+}
+
 #pragma region Leitura e impressão
 
 string getStringInput(string msg) {
@@ -52,6 +155,19 @@ string getStringInput(string msg) {
     return id;
 }
 
+// lê o tempo limite, em segundos, dos algoritmos de cobertura. significadoZero descreve o comportamento quando o
+// tempo é 0. Retorna -1 caso o input seja inválido
+double getTempoLimiteInput(string significadoZero) {
+    string tempoInput = getStringInput("Tempo limite em segundos (0 para " + significadoZero + "): ");
+    char *fim;
+    double tempoLimite = strtod(tempoInput.c_str(), &fim);
+    if (*fim != '\0' || tempoLimite < 0) {
+        cout << "Tempo limite invalido!\n";
+        return -1;
+    }
+    return tempoLimite;
+}
+
 static string getBooleanString(bool b) {
     if (b) return "Sim\n";
     else return "Nao\n";
@@ -72,7 +188,7 @@ void cleanConsole() {
 
 void showMainMenu() {
     int option = 0;
-    while (option != 9) {
+    while (option != 10) {
         cout << "Selecione uma das opcoes abaixo apertando seu respectivo numero\n";
         cout << "1. Imprimir grafo\n";
         cout << "2. Editar grafo\n";
@@ -82,7 +198,8 @@ void showMainMenu() {
         cout << "6. Caminho Minimo\n";
         cout << "7. Cobertura Minima de Vertices Ponderados\n";
         cout << "8. Salvar grafo\n";
-        cout << "9. Sair\n\n";
+        cout << "9. Metricas\n";
+        cout << "10. Sair\n\n";
         cout << "Opcao escolhida: ";
         cin >> option;
 
@@ -116,6 +233,9 @@ void showMainMenu() {
                 cout << endl;
                 break;
             case 9:
+                showMetricasMenu();
+                break;
+            case 10:
                 break;
             default:
                 cout << "Opcao invalida! \n\n";
@@ -125,13 +245,15 @@ void showMainMenu() {
 
 void showEditMenu() {
     int option = 0;
-    while (option != 5) {
+    while (option != 6) {
         cout << "Selecione uma das opcoes abaixo apertando seu respectivo numero\n";
         cout << "1. Inserir no\n";
         cout << "2. Inserir aresta\n";
         cout << "3. Excluir no\n";
         cout << "4. Excluir aresta\n";
-        cout << "5. Voltar ao menu anterior\n\n";
+        if (grafo->mantemAGM()) cout << "5. Parar de manter a arvore geradora minima a cada edicao\n";
+        else cout << "5. Manter a arvore geradora minima a cada edicao\n";
+        cout << "6. Voltar ao menu anterior\n\n";
         cout << "Opcao escolhida: ";
         cin >> option;
 
@@ -168,12 +290,17 @@ void showEditMenu() {
             }
                 break;
             case 5:
+                grafo->setManterAGM(!grafo->mantemAGM());
+                if (grafo->mantemAGM()) cout << "A arvore geradora minima sera mantida a cada edicao\n";
+                else cout << "A arvore geradora minima sera recalculada a cada consulta\n";
+                break;
+            case 6:
                 break;
             default:
                 cout << "Opcao invalida! \n\n";
         }
 
-        if (option != 5) {
+        if (option != 6) {
             cout << endl;
         }
     }
@@ -181,7 +308,7 @@ void showEditMenu() {
 
 void showInfoGrafoMenu() {
     int option = 0;
-    while (option != 13) {
+    while (option != 14) {
         cout << "Selecione uma das opcoes abaixo apertando seu respectivo numero\n";
 
 
@@ -196,8 +323,9 @@ void showInfoGrafoMenu() {
         cout << "9. Verificar a k-regularidade do grafo\n";
         cout << "10. Verificar componentes fortemente conexas\n";
         cout << "11. Verificar propriedades do grafo\n";
-        cout << "12. Mostrar arvore geradora minima\n";
-        cout << "13. Voltar ao menu anterior\n\n";
+        cout << "12. Mostrar arvore geradora minima (Kruskal)\n";
+        cout << "13. Mostrar arvore geradora minima (Boruvka paralelo)\n";
+        cout << "14. Voltar ao menu anterior\n\n";
         cout << "Opcao escolhida: ";
 
         cin >> option;
@@ -258,15 +386,18 @@ void showInfoGrafoMenu() {
                 showInfoVerificaInfoGrafoMenu();
                 break;
             case 12:
-                grafo->showArvoreGeradoraMinima();
+                grafo->showArvoreGeradoraMinima(false);
                 break;
             case 13:
+                grafo->showArvoreGeradoraMinima(true);
+                break;
+            case 14:
                 break;
             default:
                 cout << "Opcao invalida! \n\n";
         }
 
-        if (option != 2 && option != 11 && option != 13) {
+        if (option != 2 && option != 11 && option != 14) {
             cout << endl;
         }
     }
@@ -488,12 +619,16 @@ void showInfoVerificaInfoGrafoMenu() {
 
 void showCoberturaMenu() {
     int option = 0;
-    while (option != 4) {
+    while (option != 7) {
         cout << "Selecione uma das opcoes abaixo apertando seu respectivo numero\n";
         cout << "1. Guloso\n";
         cout << "2. Guloso Randomizado\n";
         cout << "3. Guloso Randomizado Reativo\n";
-        cout << "4. Voltar ao menu anterior\n\n";
+        cout << "4. Primal-Dual\n";
+        cout << "5. Exato (branch-and-reduce)\n";
+        cout << "6. Configurar semente (atual: " << grafo->getSemente() << ") e numero de threads (atual: "
+             << grafo->getNumThreads() << ")\n";
+        cout << "7. Voltar ao menu anterior\n\n";
         cout << "Opcao escolhida: ";
         cin >> option;
 
@@ -516,30 +651,36 @@ void showCoberturaMenu() {
                     cout << "Alfa deve estar entre 0 e 1 (inclusive)!\n";
                     break;
                 }
-                string numIteracoesInput = getStringInput("Numero de iteracoes: ");
-                int numIteracoes = atoi(numIteracoesInput.c_str());
-                if ((numIteracoes == 0 && numIteracoesInput != "0") || (numIteracoes <= 0)) {
-                    // quando numIteracoes é 0 e o input não especificou 0, de fato, ocorreu erro na conversão
-                    // da string para o inteiro. Neste caso, paramos
-                    cout << "Numero de iteracoes invalido!\n";
-                    break;
-                }
-                if(numIteracoes <= 0){
-                    cout << "Numero de iteracoes deve ser não negativo!\n";
-                    break;
+                double tempoLimite = getTempoLimiteInput("limitar pelo numero de iteracoes");
+                if (tempoLimite < 0) break;
+                int numIteracoes = 0;
+                if (tempoLimite == 0) {
+                    string numIteracoesInput = getStringInput("Numero de iteracoes: ");
+                    numIteracoes = atoi(numIteracoesInput.c_str());
+                    if ((numIteracoes == 0 && numIteracoesInput != "0") || (numIteracoes <= 0)) {
+                        // quando numIteracoes é 0 e o input não especificou 0, de fato, ocorreu erro na conversão
+                        // da string para o inteiro. Neste caso, paramos
+                        cout << "Numero de iteracoes invalido!\n";
+                        break;
+                    }
                 }
-                grafo->showCoberturaGulosoRandomizado(alpha, numIteracoes);
+                grafo->showCoberturaGulosoRandomizado(alpha, numIteracoes, tempoLimite);
             }
                 break;
             case 3:
             {
-                string numIteracoesInput = getStringInput("Numero de iteracoes: ");
-                int numIteracoes = atoi(numIteracoesInput.c_str());
-                if ((numIteracoes == 0 && numIteracoesInput != "0") || (numIteracoes <= 0)) {
-                    // quando numIteracoes é 0 e o input não especificou 0, de fato, ocorreu erro na conversão
-                    // da string para o inteiro. Neste caso e quando numIteracoes eh 0 ou negativo, paramos
-                    cout << "Numero de iteracoes invalido!\n";
-                    break;
+                double tempoLimite = getTempoLimiteInput("limitar pelo numero de iteracoes");
+                if (tempoLimite < 0) break;
+                int numIteracoes = 0;
+                if (tempoLimite == 0) {
+                    string numIteracoesInput = getStringInput("Numero de iteracoes: ");
+                    numIteracoes = atoi(numIteracoesInput.c_str());
+                    if ((numIteracoes == 0 && numIteracoesInput != "0") || (numIteracoes <= 0)) {
+                        // quando numIteracoes é 0 e o input não especificou 0, de fato, ocorreu erro na conversão
+                        // da string para o inteiro. Neste caso e quando numIteracoes eh 0 ou negativo, paramos
+                        cout << "Numero de iteracoes invalido!\n";
+                        break;
+                    }
                 }
                 string blocoIteracoesInput = getStringInput("Bloco de iteracoes: ");
                 int blocoIteracoes = atoi(blocoIteracoesInput.c_str());
@@ -549,16 +690,97 @@ void showCoberturaMenu() {
                     cout << "Bloco de iteracoes invalido!\n";
                     break;
                 }
-                grafo->showCoberturaGulosoRandomizadoReativo(numIteracoes, blocoIteracoes);
+                grafo->showCoberturaGulosoRandomizadoReativo(numIteracoes, blocoIteracoes, tempoLimite);
             }
                 break;
             case 4:
+                grafo->showCoberturaPrimalDual();
+                break;
+            case 5: {
+                double tempoLimite = getTempoLimiteInput("nao limitar");
+                if (tempoLimite < 0) break;
+                grafo->showCoberturaExata(tempoLimite);
+            }
+                break;
+            case 6: {
+                // uma mesma semente reproduz os mesmos resultados nos algoritmos randomizados
+                string sementeInput = getStringInput("Semente: ");
+                char *fim;
+                unsigned long long semente = strtoull(sementeInput.c_str(), &fim, 10);
+                if (*fim != '\0') {
+                    cout << "Semente invalida!\n";
+                    break;
+                }
+                string numThreadsInput = getStringInput("Numero de threads: ");
+                int numThreads = atoi(numThreadsInput.c_str());
+                if (numThreads <= 0) {
+                    cout << "Numero de threads invalido!\n";
+                    break;
+                }
+                grafo->setSemente(semente);
+                grafo->setNumThreads(numThreads);
+            }
+                break;
+            case 7:
                 break;
             default:
                 cout << "Opcao invalida! \n\n";
         }
 
-        if (option != 4) {
+        if (option != 7) {
+            cout << endl;
+        }
+    }
+}
+
+void salvarMetricas(string nomeArquivo) {
+    ofstream arquivo(nomeArquivo);
+    if (!arquivo.is_open()) {
+        cout << "Nao foi possivel abrir o arquivo de metricas " << nomeArquivo << endl;
+        return;
+    }
+    grafo->getMetricas()->escreverJson(arquivo);
+    cout << "Metricas salvas em " << nomeArquivo << endl;
+}
+
+void showMetricasMenu() {
+    int option = 0;
+    while (option != 5) {
+        cout << "Selecione uma das opcoes abaixo apertando seu respectivo numero\n";
+        if (grafo->getMetricas()->getAtivas()) cout << "1. Desligar a contagem das metricas\n";
+        else cout << "1. Ligar a contagem das metricas\n";
+        cout << "2. Mostrar metricas\n";
+        cout << "3. Salvar metricas em arquivo JSON\n";
+        cout << "4. Zerar metricas\n";
+        cout << "5. Voltar ao menu anterior\n\n";
+        cout << "Opcao escolhida: ";
+        cin >> option;
+
+        cleanConsole();
+
+        switch (option) {
+            case 1:
+                grafo->getMetricas()->setAtivas(!grafo->getMetricas()->getAtivas());
+                if (grafo->getMetricas()->getAtivas()) cout << "A contagem das metricas foi ligada\n";
+                else cout << "A contagem das metricas foi desligada\n";
+                break;
+            case 2:
+                grafo->getMetricas()->escreverJson(cout);
+                break;
+            case 3:
+                salvarMetricas(getStringInput("Nome do arquivo: "));
+                break;
+            case 4:
+                grafo->getMetricas()->zerar();
+                cout << "Metricas zeradas\n";
+                break;
+            case 5:
+                break;
+            default:
+                cout << "Opcao invalida! \n\n";
+        }
+
+        if (option != 5) {
             cout << endl;
         }
     }